@@ -2,27 +2,104 @@
 #define AUTOGRAD_H
 
 #include <algorithm>
+#include <array>
 #include <ostream>
+#include <span>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
 
 #include "concepts.h"
 #include "context.h"
 #include "graph.h"
+#include "node_ptr.h"
 
 namespace autograd {
+template <Field F>
+class Lazy;
+
+template <Field F>
+class LazyGraph;
+
+// Plain value for inference. Ops on values only run forward, so no node,
+// edge or backward function is ever allocated.
+template <Field F>
+class Value {
+    F _data;
+
+   public:
+    explicit Value(const F& data) : _data(data) {}
+
+    explicit Value(F&& data) : _data(std::move(data)) {}
+
+    [[nodiscard]] F& data() { return _data; }
+
+    [[nodiscard]] const F& data() const { return _data; }
+};
+
+// Value with tangents, its derivatives with respect to a few seed variables,
+// for forward mode. Ops on duals chain each op's backward into the tangents,
+// so local derivatives never need a node. Constants have no tangents.
+template <Field F>
+class Dual {
+   public:
+    typedef grad_t<F> GradType;
+    typedef boost::container::small_vector<GradType, 4> Tangents;
+
+   private:
+    F _data;
+    Tangents _tangents;
+
+    static GradType zero() {
+        return FieldTraits<GradType>::one - FieldTraits<GradType>::one;
+    }
+
+   public:
+    explicit Dual(const F& data) : _data(data) {}
+
+    explicit Dual(F&& data) : _data(std::move(data)) {}
+
+    // The seed-th of count variables, i.e. with a unit tangent at seed.
+    static Dual variable(const F& data, const size_t seed, const size_t count) {
+        Dual result(data);
+        result._tangents.assign(count, zero());
+        result._tangents[seed] = FieldTraits<GradType>::one;
+        return result;
+    }
+
+    [[nodiscard]] F& data() { return _data; }
+
+    [[nodiscard]] const F& data() const { return _data; }
+
+    [[nodiscard]] bool is_constant() const { return _tangents.empty(); }
+
+    [[nodiscard]] GradType tangent(const size_t seed) const {
+        return seed < _tangents.size() ? _tangents[seed] : zero();
+    }
+
+    // Adds local * the tangents of arg, where local is d(this)/d(arg).
+    void chain(typename FieldTraits<F>::arg_type local, const Dual& arg) {
+        if (_tangents.size() < arg._tangents.size())
+            _tangents.resize(arg._tangents.size(), zero());
+        for (size_t i = 0; i < arg._tangents.size(); i++)
+            _tangents[i] += local * arg._tangents[i];
+    }
+};
+
 template <Field F>
 class AutoGrad {
-    std::shared_ptr<Node<F>> node;
+    NodePtr<F> node;
 
    public:
     explicit AutoGrad(const F& data, bool requires_grad = false)
-        : node(std::make_shared<Node<F>>(data, requires_grad)) {}
+        : node(make_node<F>(data, requires_grad)) {}
 
     explicit AutoGrad(F&& data, bool requires_grad = false)
-        : node(std::make_shared<Node<F>>(data, requires_grad)) {}
+        : node(make_node<F>(data, requires_grad)) {}
 
-    explicit AutoGrad(const std::shared_ptr<Node<F>>& node) : node(node) {}
+    explicit AutoGrad(const NodePtr<F>& node) : node(node) {}
 
-    explicit AutoGrad(std::shared_ptr<Node<F>>&& node) : node(std::move(node)) {}
+    explicit AutoGrad(NodePtr<F>&& node) : node(std::move(node)) {}
 
     void connect(const AutoGrad& other) const { node->add_edge(other.node); }
 
@@ -30,7 +107,7 @@ class AutoGrad {
 
     [[nodiscard]] const F& data() const { return node->data(); }
 
-    [[nodiscard]] const F& grad() const { return node->get_grad(); }
+    [[nodiscard]] const grad_t<F>& grad() const { return node->get_grad(); }
 
     [[nodiscard]] bool requires_grad() const { return node->requires_backward(); }
 
@@ -38,11 +115,19 @@ class AutoGrad {
 
     void backward() const { node->backward(); }
 
+    BackwardStats backward_skip_zeros() const { return node->backward_skip_zeros(); }
+
+    [[nodiscard]] Node<F>* get_node() const { return &*node; }
+
     AutoGrad copy(bool requires_grad = false) const {
         return AutoGrad(node->data(), requires_grad);
     }
 
     void set_requires_grad(bool value) { node->set_requires_grad(value); }
+
+    void register_grad_hook(typename Node<F>::GradHook hook) const {
+        node->add_grad_hook(std::move(hook));
+    }
 };
 
 template <Field F, typename AutoGradFunc>
@@ -50,16 +135,36 @@ class Function {
    public:
     static AutoGrad<F> call(const AutoGrad<F>& arg) {
         F func_output = AutoGradFunc::forward(arg.data());
-        auto node = std::make_shared<Node<F>>(std::move(func_output));
-        AutoGrad<F> result(node);
+        AutoGrad<F> result(make_node<F>(std::move(func_output)));
+        Node<F>* node = result.get_node();
         if (GradContext<F>::grad_enabled() && arg.requires_grad()) {
             result.connect(arg);
-            node->set_backward_func(
-                std::make_unique<UnaryBackwardFunc<F>>(AutoGradFunc::backward)
-            );
+            node->set_backward_func(std::make_unique<UnaryBackwardFunc<F>>(
+                [](typename FieldTraits<F>::arg_type x) {
+                    return AutoGradFunc::backward(x);
+                }
+            ));
         }
         return result;
     }
+
+    static Value<F> call(const Value<F>& arg) {
+        return Value<F>(AutoGradFunc::forward(arg.data()));
+    }
+
+    static Dual<F> call(const Dual<F>& arg) {
+        Dual<F> result(AutoGradFunc::forward(arg.data()));
+        if (!arg.is_constant())
+            result.chain(AutoGradFunc::backward(arg.data()), arg);
+        return result;
+    }
+
+    static Lazy<F> call(const Lazy<F>& arg) {
+        return LazyGraph<F>::template record<AutoGradFunc>(
+            std::array{arg},
+            [](std::span<const AutoGrad<F>> args) { return call(args[0]); }
+        );
+    }
 };
 
 template <Field F, typename AutoGradBiFunc>
@@ -67,18 +172,42 @@ class BiFunction {
    public:
     static AutoGrad<F> call(const AutoGrad<F>& x, const AutoGrad<F>& y) {
         F func_output = AutoGradBiFunc::forward(x.data(), y.data());
-        auto node = std::make_shared<Node<F>>(std::move(func_output));
-        AutoGrad<F> result(node);
+        AutoGrad<F> result(make_node<F>(std::move(func_output)));
+        Node<F>* node = result.get_node();
         if (GradContext<F>::grad_enabled()
             && (x.requires_grad() || y.requires_grad())) {
             result.connect(x);
             result.connect(y);
-            node->set_backward_func(
-                std::make_unique<BinaryBackwardFunc<F>>(AutoGradBiFunc::backward)
-            );
+            node->set_backward_func(std::make_unique<BinaryBackwardFunc<F>>(
+                [](typename FieldTraits<F>::arg_type x,
+                   typename FieldTraits<F>::arg_type y) {
+                    return AutoGradBiFunc::backward(x, y);
+                }
+            ));
+        }
+        return result;
+    }
+
+    static Value<F> call(const Value<F>& x, const Value<F>& y) {
+        return Value<F>(AutoGradBiFunc::forward(x.data(), y.data()));
+    }
+
+    static Dual<F> call(const Dual<F>& x, const Dual<F>& y) {
+        Dual<F> result(AutoGradBiFunc::forward(x.data(), y.data()));
+        if (!x.is_constant() || !y.is_constant()) {
+            std::pair<F, F> grad = AutoGradBiFunc::backward(x.data(), y.data());
+            result.chain(grad.first, x);
+            result.chain(grad.second, y);
         }
         return result;
     }
+
+    static Lazy<F> call(const Lazy<F>& x, const Lazy<F>& y) {
+        return LazyGraph<F>::template record<AutoGradBiFunc>(
+            std::array{x, y},
+            [](std::span<const AutoGrad<F>> args) { return call(args[0], args[1]); }
+        );
+    }
 };
 
 template <Field F, int NUM_ARGS, typename AutoGradMultiFunc>
@@ -104,8 +233,8 @@ class MultiFunction {
         for (int i = 0; i < NUM_ARGS; i++)
             func_args[i] = args[i].data();
         F func_output = AutoGradMultiFunc::forward(func_args);
-        auto node = std::make_shared<Node<F>>(std::move(func_output));
-        AutoGrad<F> result(node);
+        AutoGrad<F> result(make_node<F>(std::move(func_output)));
+        Node<F>* node = result.get_node();
         if (GradContext<F>::grad_enabled()
             && std::any_of(args.begin(), args.end(), [](const AutoGrad<F>& arg) {
                    return arg.requires_grad();
@@ -114,12 +243,129 @@ class MultiFunction {
                 result.connect(args[i]);
             node->set_backward_func(
                 std::make_unique<MultiArgBackwardFunction<F, NUM_ARGS>>(
-                    AutoGradMultiFunc::backward
+                    [](const std::array<typename FieldTraits<F>::arg_type, NUM_ARGS>&
+                           args) { return AutoGradMultiFunc::backward(args); }
                 )
             );
         }
         return result;
     }
+
+    template <std::same_as<Value<F>> ValueArg>
+    static Value<F> call(const std::array<ValueArg, NUM_ARGS>& args) {
+        std::array<typename FieldTraits<F>::arg_type, NUM_ARGS> func_args;
+        for (int i = 0; i < NUM_ARGS; i++)
+            func_args[i] = args[i].data();
+        return Value<F>(AutoGradMultiFunc::forward(func_args));
+    }
+
+    template <std::same_as<Dual<F>> DualArg>
+    static Dual<F> call(const std::array<DualArg, NUM_ARGS>& args) {
+        std::array<typename FieldTraits<F>::arg_type, NUM_ARGS> func_args;
+        for (int i = 0; i < NUM_ARGS; i++)
+            func_args[i] = args[i].data();
+        Dual<F> result(AutoGradMultiFunc::forward(func_args));
+        if (std::any_of(args.begin(), args.end(), [](const Dual<F>& arg) {
+                return !arg.is_constant();
+            })) {
+            std::array<F, NUM_ARGS> grad = AutoGradMultiFunc::backward(func_args);
+            for (int i = 0; i < NUM_ARGS; i++)
+                result.chain(grad[i], args[i]);
+        }
+        return result;
+    }
+
+    // A template, so braced AutoGrad arguments never instantiate std::array<Lazy>.
+    template <std::same_as<Lazy<F>> LazyArg>
+    static Lazy<F> call(const std::array<LazyArg, NUM_ARGS>& args) {
+        return LazyGraph<F>::template record<AutoGradMultiFunc>(
+            args,
+            [](std::span<const AutoGrad<F>> args) {
+                return [&]<size_t... I>(std::index_sequence<I...>) {
+                    return call(std::array<AutoGrad<F>, NUM_ARGS>{args[I]...});
+                }(std::make_index_sequence<NUM_ARGS>());
+            }
+        );
+    }
+};
+
+template <Field F, typename AutoGradVariadicFunc>
+class VariadicFunction {
+    constexpr static auto NO_ARGS_ERR_MSG =
+        "autograd::VariadicFunction must take more than 0 arguments.";
+
+   protected:
+    static AutoGrad<F> make_result(
+        std::span<const AutoGrad<F>> args,
+        F&& func_output,
+        typename VariadicBackwardFunc<F>::FuncType backward
+    ) {
+        AutoGrad<F> result(make_node<F>(std::move(func_output)));
+        Node<F>* node = result.get_node();
+        if (GradContext<F>::grad_enabled()
+            && std::any_of(args.begin(), args.end(), [](const AutoGrad<F>& arg) {
+                   return arg.requires_grad();
+               })) {
+            node->reserve_edges(args.size());
+            for (const AutoGrad<F>& arg : args)
+                result.connect(arg);
+            node->set_backward_func(
+                std::make_unique<VariadicBackwardFunc<F>>(std::move(backward))
+            );
+        }
+        return result;
+    }
+
+    template <typename Arg>
+    static std::vector<F> gather(std::span<const Arg> args) {
+        if (args.empty())
+            throw std::runtime_error(NO_ARGS_ERR_MSG);
+        std::vector<F> func_args;
+        func_args.reserve(args.size());
+        for (const Arg& arg : args)
+            func_args.push_back(arg.data());
+        return func_args;
+    }
+
+   public:
+    // Spans are passed explicitly, so ops may deduce F from them.
+    static AutoGrad<F> call(std::span<const AutoGrad<F>> args) {
+        return make_result(
+            args,
+            AutoGradVariadicFunc::forward(std::span<const F>(gather(args))),
+            [](std::span<const F> args, std::span<F> grad) {
+                AutoGradVariadicFunc::backward(args, grad);
+            }
+        );
+    }
+
+    static Value<F> call(std::span<const Value<F>> args) {
+        const std::vector<F> func_args = gather(args);
+        return Value<F>(AutoGradVariadicFunc::forward(std::span<const F>(func_args)));
+    }
+
+    static Dual<F> call(std::span<const Dual<F>> args) {
+        const std::vector<F> func_args = gather(args);
+        Dual<F> result(AutoGradVariadicFunc::forward(std::span<const F>(func_args)));
+        if (std::any_of(args.begin(), args.end(), [](const Dual<F>& arg) {
+                return !arg.is_constant();
+            })) {
+            std::vector<F> grad(func_args);
+            AutoGradVariadicFunc::backward(
+                std::span<const F>(func_args), std::span<F>(grad)
+            );
+            for (size_t i = 0; i < args.size(); i++)
+                result.chain(grad[i], args[i]);
+        }
+        return result;
+    }
+
+    static Lazy<F> call(std::span<const Lazy<F>> args) {
+        return LazyGraph<F>::template record<AutoGradVariadicFunc>(
+            args,
+            [](std::span<const AutoGrad<F>> args) { return call(args); }
+        );
+    }
 };
 
 template <Field F, typename ScalarType, typename AutoGradScalarFunc>
@@ -127,16 +373,40 @@ class ScalarFunction {
    public:
     static AutoGrad<F> call(const AutoGrad<F>& arg, ScalarType scalar) {
         F func_output = AutoGradScalarFunc::forward(arg.data(), scalar);
-        auto node = std::make_shared<Node<F>>(std::move(func_output));
-        AutoGrad<F> result(node);
+        AutoGrad<F> result(make_node<F>(std::move(func_output)));
+        Node<F>* node = result.get_node();
         if (GradContext<F>::grad_enabled() && arg.requires_grad()) {
             result.connect(arg);
             node->set_backward_func(std::make_unique<ScalarBackwardFunc<F, ScalarType>>(
-                AutoGradScalarFunc::backward, scalar
+                [](typename FieldTraits<F>::arg_type x, ScalarType scalar) {
+                    return AutoGradScalarFunc::backward(x, scalar);
+                },
+                scalar
             ));
         }
         return result;
     }
+
+    static Value<F> call(const Value<F>& arg, ScalarType scalar) {
+        return Value<F>(AutoGradScalarFunc::forward(arg.data(), scalar));
+    }
+
+    static Dual<F> call(const Dual<F>& arg, ScalarType scalar) {
+        Dual<F> result(AutoGradScalarFunc::forward(arg.data(), scalar));
+        if (!arg.is_constant())
+            result.chain(AutoGradScalarFunc::backward(arg.data(), scalar), arg);
+        return result;
+    }
+
+    static Lazy<F> call(const Lazy<F>& arg, ScalarType scalar) {
+        return LazyGraph<F>::template record<AutoGradScalarFunc>(
+            std::array{arg},
+            [scalar](std::span<const AutoGrad<F>> args) {
+                return call(args[0], scalar);
+            },
+            static_cast<double>(scalar)
+        );
+    }
 };
 
 template <Field F>
@@ -242,6 +512,122 @@ class FlipSign : public Function<F, FlipSign<F>> {
     }
 };
 
+template <Field F>
+class InverseTraits<FlipSign<F>> {
+   public:
+    typedef FlipSign<F> inverse_of;
+};
+
+template <Field F>
+class Sum : public VariadicFunction<F, Sum<F>> {
+   public:
+    static F forward(std::span<const F> args) {
+        F result = args[0];
+        for (size_t i = 1; i < args.size(); i++)
+            result += args[i];
+        return result;
+    }
+
+    static void backward(std::span<const F>, std::span<F> grad) {
+        std::fill(grad.begin(), grad.end(), FieldTraits<F>::one);
+    }
+};
+
+template <Field F>
+class Mean : public VariadicFunction<F, Mean<F>> {
+   public:
+    static F forward(std::span<const F> args) {
+        return Sum<F>::forward(args) / static_cast<F>(args.size());
+    }
+
+    static void backward(std::span<const F> args, std::span<F> grad) {
+        const F weight = FieldTraits<F>::reverse(static_cast<F>(args.size()));
+        std::fill(grad.begin(), grad.end(), weight);
+    }
+};
+
+template <Field F>
+class Prod : public VariadicFunction<F, Prod<F>> {
+   public:
+    static F forward(std::span<const F> args) {
+        F result = args[0];
+        for (size_t i = 1; i < args.size(); i++)
+            result = result * args[i];
+        return result;
+    }
+
+    // Prefix and suffix products, so zero arguments need no special casing.
+    static void backward(std::span<const F> args, std::span<F> grad) {
+        F prefix = FieldTraits<F>::one;
+        for (size_t i = 0; i < args.size(); i++) {
+            grad[i] = prefix;
+            prefix = prefix * args[i];
+        }
+        F suffix = FieldTraits<F>::one;
+        for (size_t i = args.size(); i-- > 0;) {
+            grad[i] = grad[i] * suffix;
+            suffix = suffix * args[i];
+        }
+    }
+};
+
+template <Field F>
+class Dot : public VariadicFunction<F, Dot<F>> {
+    constexpr static auto SIZE_ERR_MSG =
+        "autograd::Dot arguments must have the same length.";
+
+   public:
+    static AutoGrad<F>
+    call(std::span<const AutoGrad<F>> xs, std::span<const AutoGrad<F>> ys) {
+        if (xs.size() != ys.size())
+            throw std::runtime_error(SIZE_ERR_MSG);
+        std::vector<AutoGrad<F>> args(xs.begin(), xs.end());
+        args.insert(args.end(), ys.begin(), ys.end());
+        return VariadicFunction<F, Dot<F>>::call(args);
+    }
+
+    static Value<F> call(std::span<const Value<F>> xs, std::span<const Value<F>> ys) {
+        if (xs.size() != ys.size())
+            throw std::runtime_error(SIZE_ERR_MSG);
+        std::vector<Value<F>> args(xs.begin(), xs.end());
+        args.insert(args.end(), ys.begin(), ys.end());
+        return VariadicFunction<F, Dot<F>>::call(args);
+    }
+
+    static Dual<F> call(std::span<const Dual<F>> xs, std::span<const Dual<F>> ys) {
+        if (xs.size() != ys.size())
+            throw std::runtime_error(SIZE_ERR_MSG);
+        std::vector<Dual<F>> args(xs.begin(), xs.end());
+        args.insert(args.end(), ys.begin(), ys.end());
+        return VariadicFunction<F, Dot<F>>::call(args);
+    }
+
+    static Lazy<F> call(std::span<const Lazy<F>> xs, std::span<const Lazy<F>> ys) {
+        if (xs.size() != ys.size())
+            throw std::runtime_error(SIZE_ERR_MSG);
+        std::vector<Lazy<F>> args(xs.begin(), xs.end());
+        args.insert(args.end(), ys.begin(), ys.end());
+        return VariadicFunction<F, Dot<F>>::call(args);
+    }
+
+    // Arguments are x_1, ..., x_n, y_1, ..., y_n.
+    static F forward(std::span<const F> args) {
+        const size_t n = args.size() / 2;
+        F result = args[0] * args[n];
+        for (size_t i = 1; i < n; i++)
+            result += args[i] * args[n + i];
+        return result;
+    }
+
+    static void backward(std::span<const F> args, std::span<F> grad) {
+        const size_t n = args.size() / 2;
+        for (size_t i = 0; i < n; i++) {
+            grad[i] = args[n + i];
+            grad[n + i] = args[i];
+        }
+    }
+};
+
 template <Field F>
 AutoGrad<F> operator+(const AutoGrad<F>& x, const AutoGrad<F>& y) {
     return Add<F>::call(x, y);
@@ -267,6 +653,56 @@ AutoGrad<F> operator-(const AutoGrad<F>& x) {
     return FlipSign<F>::call(x);
 }
 
+template <Field F>
+Value<F> operator+(const Value<F>& x, const Value<F>& y) {
+    return Add<F>::call(x, y);
+}
+
+template <Field F>
+Value<F> operator-(const Value<F>& x, const Value<F>& y) {
+    return Subtract<F>::call(x, y);
+}
+
+template <Field F>
+Value<F> operator*(const Value<F>& x, const Value<F>& y) {
+    return Mul<F>::call(x, y);
+}
+
+template <Field F>
+Value<F> operator/(const Value<F>& x, const Value<F>& y) {
+    return Div<F>::call(x, y);
+}
+
+template <Field F>
+Value<F> operator-(const Value<F>& x) {
+    return FlipSign<F>::call(x);
+}
+
+template <Field F>
+Dual<F> operator+(const Dual<F>& x, const Dual<F>& y) {
+    return Add<F>::call(x, y);
+}
+
+template <Field F>
+Dual<F> operator-(const Dual<F>& x, const Dual<F>& y) {
+    return Subtract<F>::call(x, y);
+}
+
+template <Field F>
+Dual<F> operator*(const Dual<F>& x, const Dual<F>& y) {
+    return Mul<F>::call(x, y);
+}
+
+template <Field F>
+Dual<F> operator/(const Dual<F>& x, const Dual<F>& y) {
+    return Div<F>::call(x, y);
+}
+
+template <Field F>
+Dual<F> operator-(const Dual<F>& x) {
+    return FlipSign<F>::call(x);
+}
+
 template <Field F>
 std::ostream& operator<<(std::ostream& stream, const AutoGrad<F>& x) {
     stream << "data: " << x.data() << " grad: ";
@@ -284,6 +720,17 @@ class FieldTraits<double> {
     constexpr static double one = 1.0;
     static double reverse(const double x) { return 1.0 / x; }
 };
+
+// Mixed precision: values and local derivatives are stored as float, while
+// gradients are accumulated in double to avoid losing small contributions.
+template <>
+class FieldTraits<float> {
+   public:
+    typedef float arg_type;
+    typedef double grad_type;
+    constexpr static float one = 1.0f;
+    static float reverse(const float x) { return 1.0f / x; }
+};
 }  // namespace autograd
 
 #endif  // AUTOGRAD_H
@@ -0,0 +1,223 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "concepts.h"
+#include "lazy.h"
+#include "op_name.h"
+
+namespace autograd {
+template <Field F>
+class CodeGenerator {
+    typedef typename LazyGraph<F>::Entry Entry;
+    typedef typename LazyGraph<F>::Form Form;
+    typedef typename LazyGraph<F>::Kind Kind;
+
+    constexpr static auto UNNAMED_OP_ERR_MSG =
+        "An op has no name valid in source, specialize OpName for it: ";
+
+    static std::string op_name(const Entry& entry) {
+        if (!entry.name)
+            throw std::runtime_error(UNNAMED_OP_ERR_MSG + demangle(entry.op));
+        return *entry.name;
+    }
+
+    // Hexadecimal floating point literals round-trip exactly. Non-finite values
+    // have no literal, e.g. after folding x / 0, and -0.0 is not an integer.
+    template <typename T>
+    static std::string literal(const T& value) {
+        std::ostringstream stream;
+        if constexpr (std::is_floating_point_v<T>) {
+            const std::string limits =
+                "std::numeric_limits<" + demangle(typeid(T)) + ">";
+            if (std::isnan(value))
+                stream << limits << "::quiet_NaN()";
+            else if (std::isinf(value))
+                stream << (value < 0 ? "-" : "") << limits << "::infinity()";
+            else if (value == std::trunc(value) && std::abs(value) < 1e15
+                     && (!std::signbit(value) || value != 0))
+                stream << static_cast<long long>(value);
+            else
+                stream << std::hexfloat << value;
+        } else {
+            stream << value;
+        }
+        return stream.str();
+    }
+
+    static std::string value(size_t id) { return "v" + std::to_string(id); }
+
+    static std::string adjoint(size_t id) { return "g" + std::to_string(id); }
+
+    static std::string value_list(const Entry& entry) {
+        std::string result;
+        for (size_t i = 0; i < entry.inputs.size(); i++)
+            result += (i == 0 ? "" : ", ") + value(entry.inputs[i]);
+        return result;
+    }
+
+    static std::string forward(const Entry& entry, const std::string& field) {
+        const std::string op = op_name(entry);
+        const std::string args = value_list(entry);
+        const std::string size = std::to_string(entry.inputs.size());
+        switch (entry.form) {
+            case Form::SCALAR:
+                return op + "::forward(" + args + ", " + literal(*entry.scalar) + ")";
+            case Form::MULTI:
+            case Form::VARIADIC:
+                return op + "::forward(std::array<" + field + ", " + size + ">{" + args
+                     + "})";
+            default:
+                return op + "::forward(" + args + ")";
+        }
+    }
+
+    // Constants have no adjoint. Ops with only constant arguments were folded,
+    // so unary ops always have one.
+    static void backward(
+        std::ostream& out,
+        const std::vector<Entry>& entries,
+        size_t id,
+        const std::string& field
+    ) {
+        const Entry& entry = entries[id];
+        const std::string op = op_name(entry);
+        const std::string args = value_list(entry);
+        const std::string size = std::to_string(entry.inputs.size());
+        const std::string source = adjoint(id);
+        const std::vector<size_t>& in = entry.inputs;
+        auto accumulate = [&](size_t i, const std::string& local) {
+            if (entries[in[i]].kind != Kind::CONSTANT)
+                out << "        " << adjoint(in[i]) << " += " << local << " * "
+                    << source << ";\n";
+        };
+        switch (entry.form) {
+            case Form::UNARY:
+                out << "    " << adjoint(in[0]) << " += " << op << "::backward(" << args
+                    << ") * " << source << ";\n";
+                break;
+            case Form::SCALAR:
+                out << "    " << adjoint(in[0]) << " += " << op << "::backward(" << args
+                    << ", " << literal(*entry.scalar) << ") * " << source << ";\n";
+                break;
+            case Form::BINARY:
+                out << "    {\n"
+                    << "        const auto d = " << op << "::backward(" << args
+                    << ");\n";
+                accumulate(0, "d.first");
+                accumulate(1, "d.second");
+                out << "    }\n";
+                break;
+            case Form::MULTI:
+                out << "    {\n"
+                    << "        const auto d = " << op << "::backward(std::array<"
+                    << field << ", " << size << ">{" << args << "});\n";
+                for (size_t i = 0; i < in.size(); i++)
+                    accumulate(i, "d[" + std::to_string(i) + "]");
+                out << "    }\n";
+                break;
+            case Form::VARIADIC:
+                out << "    {\n"
+                    << "        const std::array<" << field << ", " << size
+                    << "> args{" << args << "};\n"
+                    << "        std::array<" << field << ", " << size
+                    << "> d = args;\n"
+                    << "        " << op << "::backward(args, d);\n";
+                for (size_t i = 0; i < in.size(); i++)
+                    accumulate(i, "d[" + std::to_string(i) + "]");
+                out << "    }\n";
+                break;
+            case Form::NONE:
+                break;
+        }
+    }
+
+   public:
+    // Emits a header with a straight-line function computing the outputs and the
+    // vector-Jacobian product of the optimized graph:
+    //   void name(const F* inputs, F* outputs, const G* output_grads, G* input_grads)
+    // where inputs are numbered as in LazyGraph::input and G is grad_t<F>. The
+    // function calls the same forward and backward functions as the graph does.
+    static std::string generate(
+        LazyGraph<F>& graph,
+        std::span<const Lazy<F>> outputs,
+        const std::string& name,
+        std::span<const std::string> includes
+    ) {
+        typename LazyGraph<F>::Plan plan = graph.optimize(outputs);
+        const std::vector<Entry>& entries = plan.entries;
+        const std::string field = demangle(typeid(F));
+        const std::string grad = demangle(typeid(grad_t<F>));
+        std::string guard = name + "_H";
+        std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+        std::ostringstream out;
+        out << "// Generated by autograd::CodeGenerator, do not edit.\n"
+            << "#ifndef " << guard << "\n"
+            << "#define " << guard << "\n\n"
+            << "#include <array>\n"
+            << "#include <limits>\n\n"
+            << "#include \"autograd/core/autograd.h\"\n";
+        for (const std::string& include : includes)
+            out << "#include \"" << include << "\"\n";
+        out << "\n"
+            << "inline void " << name << "(\n"
+            << "    const " << field << "* inputs,\n"
+            << "    " << field << "* outputs,\n"
+            << "    const " << grad << "* output_grads,\n"
+            << "    " << grad << "* input_grads\n"
+            << ") {\n";
+
+        for (size_t id = 0; id < entries.size(); id++) {
+            const Entry& entry = entries[id];
+            if (!plan.live[id])
+                continue;
+            out << "    const " << field << " " << value(id) << " = ";
+            if (entry.kind == Kind::INPUT)
+                out << "inputs[" << entry.index << "];\n";
+            else if (entry.kind == Kind::CONSTANT)
+                out << literal(entry.value->data()) << ";\n";
+            else
+                out << forward(entry, field) << ";\n";
+        }
+        for (size_t i = 0; i < plan.roots.size(); i++)
+            out << "    outputs[" << i << "] = " << value(plan.roots[i]) << ";\n";
+
+        out << "\n";
+        for (size_t id = 0; id < entries.size(); id++) {
+            if (plan.live[id] && entries[id].kind != Kind::CONSTANT)
+                out << "    " << grad << " " << adjoint(id) << "{};\n";
+        }
+        for (size_t i = 0; i < plan.roots.size(); i++) {
+            if (entries[plan.roots[i]].kind != Kind::CONSTANT)
+                out << "    " << adjoint(plan.roots[i]) << " += output_grads[" << i
+                    << "];\n";
+        }
+        for (size_t id = entries.size(); id-- > 0;) {
+            if (plan.live[id] && entries[id].kind == Kind::OP)
+                backward(out, entries, id, field);
+        }
+
+        out << "\n";
+        for (size_t i = 0; i < graph.input_count(); i++)
+            out << "    input_grads[" << i << "] = " << grad << "{};\n";
+        for (size_t id = 0; id < entries.size(); id++) {
+            if (plan.live[id] && entries[id].kind == Kind::INPUT)
+                out << "    input_grads[" << entries[id].index << "] += " << adjoint(id)
+                    << ";\n";
+        }
+        out << "}\n\n"
+            << "#endif  // " << guard << "\n";
+        return out.str();
+    }
+};
+}  // namespace autograd
+
+#endif  // CODEGEN_H
@@ -24,6 +24,32 @@ concept Field = requires(T x, T y) {
     { FieldTraits<T>::reverse(x) };
     typename FieldTraits<T>::arg_type;
 };
+
+template <typename T>
+class GradTraits {
+   public:
+    typedef T grad_type;
+};
+
+// Fields may opt into a wider gradient accumulator by declaring
+// FieldTraits<T>::grad_type, e.g. float values with double gradients.
+template <typename T>
+    requires requires { typename FieldTraits<T>::grad_type; }
+class GradTraits<T> {
+   public:
+    typedef typename FieldTraits<T>::grad_type grad_type;
+};
+
+template <typename T>
+using grad_t = typename GradTraits<T>::grad_type;
+
+// Declares that Op(Inner(x)) == x for every x, e.g. Ln(Exp(x)). Used by the
+// lazy graph to cancel such compositions.
+template <typename Op>
+class InverseTraits {
+   public:
+    typedef void inverse_of;
+};
 }  // namespace autograd
 
 #endif  // CONCEPTS_H
@@ -4,7 +4,8 @@
 namespace autograd {
 template <typename T>
 class GradContext {
-    static int context_counter;
+    // Per thread, so no_grad() scopes never leak into other threads' graphs.
+    static thread_local int context_counter;
 
     GradContext() { context_counter++; }
 
@@ -17,7 +18,7 @@ class GradContext {
 };
 
 template <typename T>
-int GradContext<T>::context_counter = 0;
+thread_local int GradContext<T>::context_counter = 0;
 }  // namespace autograd
 
 #endif  // CONTEXT_H
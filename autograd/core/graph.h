@@ -1,9 +1,12 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <concepts>
 #include <functional>
 #include <memory>
 #include <ranges>
+#include <span>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -11,18 +14,25 @@
 
 #include "concepts.h"
 #include "constants.h"
+#include "node_ptr.h"
 
 namespace autograd {
 template <Field F>
 class Node;
 
+class BackwardStats {
+   public:
+    size_t visited = 0;
+    size_t skipped = 0;
+};
+
 template <Field F>
 class BackwardFunc {
    protected:
     static void pass_to_target(
         Node<F>* target,
         typename FieldTraits<F>::arg_type target_grad,
-        typename FieldTraits<F>::arg_type source_grad
+        typename Node<F>::GradArgType source_grad
     ) {
         if (target->requires_backward())
             target->accumulate_grad(target_grad * source_grad);
@@ -31,16 +41,19 @@ class BackwardFunc {
    public:
     virtual void backward(
         typename Node<F>::BackwardEdges& targets,
-        typename FieldTraits<F>::arg_type source_grad
+        typename Node<F>::GradArgType source_grad
     ) = 0;
     virtual ~BackwardFunc() = default;
 };
 
 template <Field F>
-class Node {
+class Node : public NodeBase<F> {
    public:
-    typedef boost::container::small_vector<std::shared_ptr<Node>, INLINE_EDGE_CAPACITY>
+    typedef boost::container::small_vector<NodePtr<F>, INLINE_EDGE_CAPACITY>
         BackwardEdges;
+    typedef grad_t<F> GradType;
+    typedef typename FieldTraits<GradType>::arg_type GradArgType;
+    typedef std::function<void(const GradType&)> GradHook;
 
    private:
     constexpr static auto SECOND_PASS_ERR_MSG =
@@ -50,35 +63,47 @@ class Node {
         "function defined.";
     constexpr static auto SET_REQUIRES_GRAD_ERR_MSG =
         "Changing requires_grad is possible only for leaf nodes.";
+    constexpr static auto HOOK_ERR_MSG =
+        "Gradient hooks can be registered only on leaf nodes.";
 
     F _data;
     bool requires_grad;
-    std::unique_ptr<F> grad = nullptr;
+    std::unique_ptr<GradType> grad = nullptr;
     std::unique_ptr<BackwardFunc<F>> backward_func = nullptr;
     BackwardEdges backward_edges;
+    bool released = false;
+    std::unique_ptr<std::vector<GradHook>> grad_hooks = nullptr;
 
+    // Appends every node reachable through the edges, but not this one, each
+    // after the nodes it depends on. Entries are either Node* or NodePtr<F>.
+    template <typename Entry>
     void topological_sort_recursion(
-        std::vector<Node*>& result,
+        std::vector<Entry>& result,
         std::unordered_set<Node*>& visited
     ) {
         visited.insert(this);
-        for (size_t i = 0; i < backward_edges.size(); i++) {
-            if (!visited.contains(backward_edges[i].get()))
-                backward_edges[i]->topological_sort_recursion(result, visited);
+        for (const NodePtr<F>& edge : backward_edges) {
+            if (!visited.contains(edge.get())) {
+                edge->topological_sort_recursion(result, visited);
+                if constexpr (std::same_as<Entry, NodePtr<F>>)
+                    result.push_back(edge);
+                else
+                    result.push_back(edge.get());
+            }
         }
-        result.push_back(this);
     }
 
-    std::vector<Node*> topological_sort() {
-        std::vector<Node*> result;
-        std::unordered_set<Node*> visited;
-        topological_sort_recursion(result, visited);
-        std::reverse(result.begin(), result.end());
-        return result;
+    static void propagate(const std::vector<Node*>& order) {
+        for (Node* node :
+             order | std::views::filter([](const Node* n) { return !n->is_leaf(); })) {
+            node->pre_backward();
+            node->do_backward();
+            node->post_backward();
+        }
     }
 
     void pre_backward() {
-        if (!is_leaf() && backward_edges.empty())
+        if (released)
             throw std::runtime_error(SECOND_PASS_ERR_MSG);
     }
 
@@ -89,6 +114,98 @@ class Node {
             grad = nullptr;
     }
 
+    void run_grad_hooks() const {
+        if (grad == nullptr)
+            return;
+        for (const GradHook& hook : *grad_hooks)
+            hook(*grad);
+    }
+
+    // Counts the contributions this node passes to hooked leaves, so pending
+    // ends up with the number each leaf is still waiting for.
+    void count_pending(std::unordered_map<Node*, size_t>& pending) const {
+        for (const NodePtr<F>& edge : backward_edges) {
+            if (edge->grad_hooks != nullptr)
+                pending[edge.get()]++;
+        }
+    }
+
+    // Runs the hooks of every leaf whose last contribution was just passed.
+    void notify_pending(std::unordered_map<Node*, size_t>& pending) const {
+        for (const NodePtr<F>& edge : backward_edges) {
+            if (edge->grad_hooks != nullptr && --pending[edge.get()] == 0)
+                edge->run_grad_hooks();
+        }
+    }
+
+    // A gradient that is known to pass nothing on. Fields that cannot be compared
+    // are only skipped when no gradient reached the node at all.
+    [[nodiscard]] bool has_zero_grad() const {
+        if (grad == nullptr)
+            return true;
+        if constexpr (std::equality_comparable<GradType>) {
+            const GradType one = FieldTraits<GradType>::one;
+            return *grad == one - one;
+        } else {
+            return false;
+        }
+    }
+
+    void sweep_node(
+        const bool skip_zeros,
+        std::unordered_map<Node*, size_t>& pending,
+        BackwardStats& stats
+    ) {
+        if (is_leaf())
+            return;
+        pre_backward();
+        if (skip_zeros && has_zero_grad()) {
+            stats.skipped++;
+        } else {
+            do_backward();
+            stats.visited++;
+        }
+        post_backward();
+        if (!pending.empty())
+            notify_pending(pending);
+        release();
+    }
+
+    BackwardStats sweep(const bool skip_zeros) {
+        if (!requires_backward())
+            throw std::runtime_error(BACKWARD_ERR_MSG);
+        // The order owns every node below the root, and drops each one once it
+        // has been processed. Nodes nothing else holds are freed right away.
+        std::vector<NodePtr<F>> order;
+        {
+            std::unordered_set<Node*> visited;
+            topological_sort_recursion(order, visited);
+        }
+        std::reverse(order.begin(), order.end());
+        std::unordered_map<Node*, size_t> pending;
+        count_pending(pending);
+        for (const NodePtr<F>& node : order)
+            node->count_pending(pending);
+        grad = std::make_unique<GradType>(FieldTraits<F>::one);
+        if (is_leaf() && grad_hooks != nullptr)
+            run_grad_hooks();
+        BackwardStats stats;
+        sweep_node(skip_zeros, pending, stats);
+        for (NodePtr<F>& node : order) {
+            node->sweep_node(skip_zeros, pending, stats);
+            node = nullptr;
+        }
+        return stats;
+    }
+
+    // Called once the gradient has been passed on: nothing in this pass needs
+    // the edges or the backward function any more.
+    void release() {
+        backward_edges.clear();
+        backward_func = nullptr;
+        released = true;
+    }
+
    public:
     explicit Node(const F& data, const bool requires_grad = false)
         : _data(data), requires_grad(requires_grad) {}
@@ -96,30 +213,51 @@ class Node {
     explicit Node(F&& data, const bool requires_grad = false)
         : _data(std::move(data)), requires_grad(requires_grad) {}
 
-    void add_edge(const std::shared_ptr<Node>& edge) { backward_edges.push_back(edge); }
+    void add_edge(const NodePtr<F>& edge) { backward_edges.push_back(edge); }
 
-    void add_edge(std::shared_ptr<Node>&& edge) {
+    void add_edge(NodePtr<F>&& edge) {
         backward_edges.push_back(std::move(edge));
     }
 
-    void backward() {
-        if (!requires_backward())
-            throw std::runtime_error(BACKWARD_ERR_MSG);
-        std::vector<Node*> order = topological_sort();
-        grad = std::make_unique<F>(FieldTraits<F>::one);
-        for (Node* node :
-             order | std::views::filter([](const Node* n) { return !n->is_leaf(); })) {
-            node->pre_backward();
-            node->do_backward();
-            node->post_backward();
+    void reserve_edges(const size_t count) { backward_edges.reserve(count); }
+
+    void backward() { sweep(false); }
+
+    // Like backward(), but nodes whose gradient is zero do not run their
+    // backward function, so whole subtrees behind e.g. an inactive ReLU are
+    // skipped. Leaves reached only through skipped nodes get no gradient.
+    BackwardStats backward_skip_zeros() { return sweep(true); }
+
+    // Backward from several roots at once, each seeded with one. The graph is
+    // kept, so further passes over it are possible.
+    static void retained_backward(std::span<Node* const> roots) {
+        for (Node* root : roots) {
+            if (!root->requires_backward())
+                throw std::runtime_error(BACKWARD_ERR_MSG);
         }
-        for (auto it = order.rbegin(); it != order.rend(); ++it)
-            (*it)->backward_edges.clear();  // "garbage collect"
+        std::vector<Node*> order = topological_sort(roots);
+        for (Node* root : roots)
+            root->grad = std::make_unique<GradType>(FieldTraits<F>::one);
+        propagate(order);
     }
 
-    void accumulate_grad(typename FieldTraits<F>::arg_type passed_value) {
+    // Every node reachable from the roots, each before the nodes it depends on.
+    static std::vector<Node*> topological_sort(std::span<Node* const> roots) {
+        std::vector<Node*> result;
+        std::unordered_set<Node*> visited;
+        for (Node* root : roots) {
+            if (!visited.contains(root)) {
+                root->topological_sort_recursion(result, visited);
+                result.push_back(root);
+            }
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    void accumulate_grad(GradArgType passed_value) {
         if (grad == nullptr)
-            grad = std::make_unique<F>(passed_value);
+            grad = std::make_unique<GradType>(passed_value);
         else
             *grad += passed_value;
     }
@@ -128,13 +266,25 @@ class Node {
         backward_func = std::move(func);
     }
 
+    // Hooks run during backward() as soon as this leaf has received its last
+    // contribution, while the rest of the graph is still being processed.
+    void add_grad_hook(GradHook hook) {
+        if (!is_leaf())
+            throw std::runtime_error(HOOK_ERR_MSG);
+        if (grad_hooks == nullptr)
+            grad_hooks = std::make_unique<std::vector<GradHook>>();
+        grad_hooks->push_back(std::move(hook));
+    }
+
     void set_requires_grad(const bool value) {
         if (!is_leaf())
             throw std::runtime_error(SET_REQUIRES_GRAD_ERR_MSG);
         requires_grad = value;
     }
 
-    [[nodiscard]] bool is_leaf() const { return backward_func == nullptr; }
+    [[nodiscard]] bool is_leaf() const {
+        return backward_func == nullptr && !released;
+    }
 
     [[nodiscard]] bool requires_backward() const { return !is_leaf() || requires_grad; }
 
@@ -142,13 +292,17 @@ class Node {
 
     [[nodiscard]] const F& data() const { return _data; }
 
-    [[nodiscard]] const F& get_grad() const {
+    [[nodiscard]] const GradType& get_grad() const {
         if (grad == nullptr)
             throw std::runtime_error("Accessing gradient of a node with no gradient.");
         return *grad;
     }
 
     [[nodiscard]] bool has_grad() const { return grad != nullptr; }
+
+    void clear_grad() { grad = nullptr; }
+
+    [[nodiscard]] const BackwardEdges& edges() const { return backward_edges; }
 };
 
 template <Field F>
@@ -161,7 +315,7 @@ class UnaryBackwardFunc final : public BackwardFunc<F> {
 
     void backward(
         typename Node<F>::BackwardEdges& targets,
-        typename FieldTraits<F>::arg_type source_grad
+        typename Node<F>::GradArgType source_grad
     ) override {
         BackwardFunc<F>::pass_to_target(
             targets[0].get(), func(targets[0]->data()), source_grad
@@ -186,7 +340,7 @@ class BinaryBackwardFunc final : public BackwardFunc<F> {
 
     void backward(
         typename Node<F>::BackwardEdges& targets,
-        typename FieldTraits<F>::arg_type source_grad
+        typename Node<F>::GradArgType source_grad
     ) override {
         std::pair<F, F> grad = func(targets[0]->data(), targets[1]->data());
         BackwardFunc<F>::pass_to_target(targets[0].get(), grad.first, source_grad);
@@ -211,7 +365,7 @@ class MultiArgBackwardFunction final : public BackwardFunc<F> {
 
     void backward(
         typename Node<F>::BackwardEdges& targets,
-        typename FieldTraits<F>::arg_type source_grad
+        typename Node<F>::GradArgType source_grad
     ) override {
         std::array<typename FieldTraits<F>::arg_type, NUM_ARGS> grad_args;
         for (int i = 0; i < NUM_ARGS; i++)
@@ -222,6 +376,32 @@ class MultiArgBackwardFunction final : public BackwardFunc<F> {
     }
 };
 
+template <Field F>
+class VariadicBackwardFunc final : public BackwardFunc<F> {
+   public:
+    typedef std::function<void(std::span<const F>, std::span<F>)> FuncType;
+
+   private:
+    FuncType func;
+
+   public:
+    explicit VariadicBackwardFunc(FuncType func) : func(std::move(func)) {}
+
+    void backward(
+        typename Node<F>::BackwardEdges& targets,
+        typename Node<F>::GradArgType source_grad
+    ) override {
+        std::vector<F> grad_args;
+        grad_args.reserve(targets.size());
+        for (const auto& target : targets)
+            grad_args.push_back(target->data());
+        std::vector<F> grad(grad_args);
+        func(grad_args, grad);
+        for (size_t i = 0; i < targets.size(); i++)
+            BackwardFunc<F>::pass_to_target(targets[i].get(), grad[i], source_grad);
+    }
+};
+
 template <Field F, typename ScalarType>
 class ScalarBackwardFunc final : public BackwardFunc<F> {
     typedef std::function<F(typename FieldTraits<F>::arg_type, ScalarType)> FuncType;
@@ -233,7 +413,7 @@ class ScalarBackwardFunc final : public BackwardFunc<F> {
 
     void backward(
         typename Node<F>::BackwardEdges& targets,
-        typename FieldTraits<F>::arg_type source_grad
+        typename Node<F>::GradArgType source_grad
     ) override {
         BackwardFunc<F>::pass_to_target(
             targets[0].get(), func(targets[0]->data(), scalar), source_grad
@@ -0,0 +1,156 @@
+#ifndef IMPLICIT_H
+#define IMPLICIT_H
+
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "autograd.h"
+#include "concepts.h"
+
+namespace autograd {
+// Solvers run outside the graph, on Value<F>, or on Dual<F> where they need a
+// derivative. The solution is recorded as a single node depending on the
+// params only, whose derivatives come from the implicit function theorem at
+// the solution, so neither the graph nor the backward pass grow with the
+// number of iterations. Functions are written once with `auto` arguments and
+// must accept both handles, as for Scan.
+template <Field F>
+    requires std::totally_ordered<F>
+class Implicit {
+   protected:
+    typedef grad_t<F> GradType;
+
+    constexpr static auto CONVERGENCE_ERR_MSG =
+        "Implicit solve did not converge within the iteration limit.";
+
+    class Partials {
+       public:
+        F value;
+        GradType x;
+        std::vector<GradType> params;
+    };
+
+    static bool within(const F& difference, const F& tolerance) {
+        return difference <= tolerance && -difference <= tolerance;
+    }
+
+    // Value and derivatives of func(x, params) in forward mode, with x as seed
+    // 0 and param j as seed j + 1.
+    template <typename Func>
+    static Partials partials(const Func& func, const F& x, std::span<const F> params) {
+        const size_t count = params.size() + 1;
+        std::vector<Dual<F>> param_duals;
+        param_duals.reserve(params.size());
+        for (size_t j = 0; j < params.size(); j++)
+            param_duals.push_back(Dual<F>::variable(params[j], j + 1, count));
+        const Dual<F> y =
+            func(Dual<F>::variable(x, 0, count), std::span(std::as_const(param_duals)));
+
+        Partials result{y.data(), y.tangent(0), {}};
+        result.params.reserve(params.size());
+        for (size_t j = 0; j < params.size(); j++)
+            result.params.push_back(y.tangent(j + 1));
+        return result;
+    }
+
+    static std::vector<Value<F>> values(std::span<const AutoGrad<F>> params) {
+        std::vector<Value<F>> result;
+        result.reserve(params.size());
+        for (const AutoGrad<F>& param : params)
+            result.emplace_back(param.data());
+        return result;
+    }
+};
+
+// Solves x = func(x, params) by iterating from x0 until successive iterates
+// are within tolerance. dx/dparam = (df/dparam) / (1 - df/dx).
+template <Field F>
+    requires std::totally_ordered<F>
+class FixedPoint : public VariadicFunction<F, FixedPoint<F>>, Implicit<F> {
+    typedef Implicit<F> Base;
+
+   public:
+    template <typename Func>
+    static AutoGrad<F> call(
+        Func func,
+        const F& x0,
+        std::span<const AutoGrad<F>> params,
+        const F& tolerance,
+        const size_t max_iterations = 100
+    ) {
+        std::vector<Value<F>> param_values = Base::values(params);
+        F x = x0;
+        for (size_t i = 0;; i++) {
+            if (i == max_iterations)
+                throw std::runtime_error(Base::CONVERGENCE_ERR_MSG);
+            F next = func(Value<F>(x), std::span(std::as_const(param_values))).data();
+            const bool converged = Base::within(next - x, tolerance);
+            x = std::move(next);
+            if (converged)
+                break;
+        }
+
+        F result = x;
+        return VariadicFunction<F, FixedPoint<F>>::make_result(
+            params,
+            std::move(result),
+            [func, x](std::span<const F> args, std::span<F> grad) {
+                typename Base::Partials d = Base::partials(func, x, args);
+                const auto one = FieldTraits<typename Base::GradType>::one;
+                for (size_t j = 0; j < args.size(); j++)
+                    grad[j] = static_cast<F>(d.params[j] / (one - d.x));
+            }
+        );
+    }
+};
+
+// Finds a root of func(x, params) with Newton's method from x0, stopping once
+// |func| is within tolerance. dx/dparam = -(dg/dparam) / (dg/dx).
+template <Field F>
+    requires std::totally_ordered<F>
+class RootSolve : public VariadicFunction<F, RootSolve<F>>, Implicit<F> {
+    typedef Implicit<F> Base;
+
+   public:
+    template <typename Func>
+    static AutoGrad<F> call(
+        Func func,
+        const F& x0,
+        std::span<const AutoGrad<F>> params,
+        const F& tolerance,
+        const size_t max_iterations = 100
+    ) {
+        // Newton only needs dg/dx, so the params are constants here.
+        std::vector<Dual<F>> constants;
+        constants.reserve(params.size());
+        for (const AutoGrad<F>& param : params)
+            constants.emplace_back(param.data());
+        F x = x0;
+        for (size_t i = 0;; i++) {
+            const Dual<F> g =
+                func(Dual<F>::variable(x, 0, 1), std::span(std::as_const(constants)));
+            if (Base::within(g.data(), tolerance))
+                break;
+            if (i == max_iterations)
+                throw std::runtime_error(Base::CONVERGENCE_ERR_MSG);
+            x = x - static_cast<F>(g.data() / g.tangent(0));
+        }
+
+        F result = x;
+        return VariadicFunction<F, RootSolve<F>>::make_result(
+            params,
+            std::move(result),
+            [func, x](std::span<const F> args, std::span<F> grad) {
+                typename Base::Partials d = Base::partials(func, x, args);
+                for (size_t j = 0; j < args.size(); j++)
+                    grad[j] = static_cast<F>(-(d.params[j] / d.x));
+            }
+        );
+    }
+};
+}  // namespace autograd
+
+#endif  // IMPLICIT_H
@@ -0,0 +1,188 @@
+#ifndef JACOBIAN_H
+#define JACOBIAN_H
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "autograd.h"
+#include "concepts.h"
+#include "graph.h"
+
+namespace autograd {
+template <Field F>
+class CsrMatrix {
+   public:
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<size_t> row_offsets;
+    std::vector<size_t> col_indices;
+    std::vector<grad_t<F>> values;
+
+    [[nodiscard]] size_t non_zeros() const { return values.size(); }
+
+    [[nodiscard]] std::optional<grad_t<F>> at(size_t row, size_t col) const {
+        auto begin = col_indices.begin() + row_offsets[row];
+        auto end = col_indices.begin() + row_offsets[row + 1];
+        auto it = std::lower_bound(begin, end, col);
+        if (it == end || *it != col)
+            return std::nullopt;
+        return values[it - col_indices.begin()];
+    }
+};
+
+// Jacobian of outputs with respect to input leaves. The sparsity pattern is read
+// from the graph edges and rows sharing no input are grouped into one color, so
+// compute() needs one backward pass per color instead of one per output.
+template <Field F>
+class SparseJacobian {
+    constexpr static auto INPUT_ERR_MSG =
+        "Jacobian inputs must be leaves that require grad.";
+
+    // The handles own the graph, so callers may drop theirs before compute().
+    std::vector<AutoGrad<F>> handles;
+    std::vector<Node<F>*> outputs;
+    std::vector<Node<F>*> inputs;
+    std::vector<std::vector<size_t>> pattern;
+    std::vector<std::vector<size_t>> color_rows;
+
+    void detect_pattern() {
+        std::unordered_map<Node<F>*, size_t> input_cols;
+        for (size_t col = 0; col < inputs.size(); col++)
+            input_cols.emplace(inputs[col], col);
+
+        std::vector<Node<F>*> order = Node<F>::topological_sort(outputs);
+        std::unordered_map<Node<F>*, std::vector<size_t>> reach;
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            Node<F>* node = *it;
+            std::vector<size_t> cols;
+            if (auto col = input_cols.find(node); col != input_cols.end())
+                cols.push_back(col->second);
+            for (const NodePtr<F>& edge : node->edges()) {
+                const std::vector<size_t>& edge_cols = reach[&*edge];
+                std::vector<size_t> merged;
+                std::set_union(
+                    cols.begin(),
+                    cols.end(),
+                    edge_cols.begin(),
+                    edge_cols.end(),
+                    std::back_inserter(merged)
+                );
+                cols = std::move(merged);
+            }
+            reach[node] = std::move(cols);
+        }
+        for (Node<F>* output : outputs)
+            pattern.push_back(reach[output]);
+    }
+
+    void color() {
+        std::vector<std::vector<size_t>> col_rows(inputs.size());
+        for (size_t row = 0; row < pattern.size(); row++) {
+            for (size_t col : pattern[row])
+                col_rows[col].push_back(row);
+        }
+        std::vector<std::optional<size_t>> row_color(pattern.size());
+        for (size_t row = 0; row < pattern.size(); row++) {
+            if (pattern[row].empty())
+                continue;
+            std::vector<bool> taken(color_rows.size(), false);
+            for (size_t col : pattern[row]) {
+                for (size_t other : col_rows[col]) {
+                    if (row_color[other])
+                        taken[*row_color[other]] = true;
+                }
+            }
+            size_t free = std::find(taken.begin(), taken.end(), false) - taken.begin();
+            if (free == color_rows.size())
+                color_rows.emplace_back();
+            color_rows[free].push_back(row);
+            row_color[row] = free;
+        }
+    }
+
+   public:
+    SparseJacobian(
+        std::span<const AutoGrad<F>> outputs,
+        std::span<const AutoGrad<F>> inputs
+    ) {
+        handles.reserve(outputs.size() + inputs.size());
+        for (const AutoGrad<F>& output : outputs) {
+            handles.push_back(output);
+            this->outputs.push_back(output.get_node());
+        }
+        for (const AutoGrad<F>& input : inputs) {
+            if (!input.get_node()->is_leaf() || !input.requires_grad())
+                throw std::runtime_error(INPUT_ERR_MSG);
+            handles.push_back(input);
+            this->inputs.push_back(input.get_node());
+        }
+        detect_pattern();
+        color();
+    }
+
+    [[nodiscard]] size_t colors() const { return color_rows.size(); }
+
+    [[nodiscard]] const std::vector<std::vector<size_t>>& sparsity() const {
+        return pattern;
+    }
+
+    // Gradients already stored in the leaves are left untouched and the graph is
+    // kept, so it can still be used for a regular backward afterwards.
+    CsrMatrix<F> compute() const {
+        typedef grad_t<F> GradType;
+        std::vector<Node<F>*> leaves;
+        std::vector<std::optional<GradType>> saved;
+        for (Node<F>* node : Node<F>::topological_sort(outputs)) {
+            if (node->is_leaf() && node->requires_backward()) {
+                leaves.push_back(node);
+                saved.push_back(
+                    node->has_grad() ? std::optional(node->get_grad()) : std::nullopt
+                );
+                node->clear_grad();
+            }
+        }
+
+        std::vector<std::vector<GradType>> row_values(pattern.size());
+        std::vector<Node<F>*> roots;
+        for (const std::vector<size_t>& rows : color_rows) {
+            roots.clear();
+            for (size_t row : rows)
+                roots.push_back(outputs[row]);
+            Node<F>::retained_backward(roots);
+            for (size_t row : rows) {
+                for (size_t col : pattern[row])
+                    row_values[row].push_back(inputs[col]->get_grad());
+            }
+            for (Node<F>* leaf : leaves)
+                leaf->clear_grad();
+        }
+
+        for (size_t i = 0; i < leaves.size(); i++) {
+            if (saved[i])
+                leaves[i]->accumulate_grad(*saved[i]);
+        }
+
+        CsrMatrix<F> result;
+        result.rows = outputs.size();
+        result.cols = inputs.size();
+        result.row_offsets.push_back(0);
+        for (size_t row = 0; row < pattern.size(); row++) {
+            result.col_indices.insert(
+                result.col_indices.end(), pattern[row].begin(), pattern[row].end()
+            );
+            result.values.insert(
+                result.values.end(), row_values[row].begin(), row_values[row].end()
+            );
+            result.row_offsets.push_back(result.col_indices.size());
+        }
+        return result;
+    }
+};
+}  // namespace autograd
+
+#endif  // JACOBIAN_H
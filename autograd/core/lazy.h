@@ -0,0 +1,335 @@
+#ifndef LAZY_H
+#define LAZY_H
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+#include "autograd.h"
+#include "concepts.h"
+#include "op_name.h"
+
+namespace autograd {
+class LazyStats {
+   public:
+    size_t recorded = 0;
+    size_t folded = 0;
+    size_t simplified = 0;
+    size_t merged = 0;
+    size_t removed = 0;
+    size_t executed = 0;
+};
+
+template <Field F>
+class Lazy {
+    LazyGraph<F>* _graph;
+    size_t _id;
+
+   public:
+    Lazy(LazyGraph<F>* graph, const size_t id) : _graph(graph), _id(id) {}
+
+    [[nodiscard]] LazyGraph<F>& graph() const { return *_graph; }
+
+    [[nodiscard]] size_t id() const { return _id; }
+};
+
+// Records operations on Lazy<F> handles without computing them. optimize() runs
+// constant folding, algebraic simplification, common sub-expression elimination
+// and dead node removal; evaluate() then builds the eager AutoGrad graph.
+template <Field F>
+class LazyGraph {
+   public:
+    typedef std::function<AutoGrad<F>(std::span<const AutoGrad<F>>)> Executor;
+
+    enum class Kind { INPUT, CONSTANT, OP };
+
+    // Which call template recorded the op, i.e. the signature of its forward.
+    enum class Form { NONE, UNARY, BINARY, MULTI, SCALAR, VARIADIC };
+
+    class Entry {
+       public:
+        Kind kind;
+        Form form = Form::NONE;
+        std::type_index op = typeid(void);
+        std::type_index inverse_of = typeid(void);
+        std::optional<std::string> name;
+        std::vector<size_t> inputs;
+        std::optional<double> scalar;
+        size_t index = 0;
+        Executor execute;
+        std::optional<AutoGrad<F>> value;
+    };
+
+    // Optimized graph in topological order. Only live entries are needed to
+    // compute the roots.
+    class Plan {
+       public:
+        std::vector<Entry> entries;
+        std::vector<bool> live;
+        std::vector<size_t> roots;
+    };
+
+   private:
+    constexpr static auto GRAPH_MISMATCH_ERR_MSG =
+        "Mixing lazy values recorded in different graphs.";
+    constexpr static auto NO_ARGS_ERR_MSG =
+        "Recording a lazy operation with no arguments.";
+
+    typedef std::tuple<std::type_index, std::vector<size_t>, std::optional<double>>
+        Key;
+
+    std::vector<Entry> entries;
+    size_t inputs_count = 0;
+    LazyStats _stats;
+
+    static Entry value_entry(const Kind kind, const AutoGrad<F>& value) {
+        Entry entry{kind};
+        entry.value = value;
+        return entry;
+    }
+
+    Lazy<F> push(Entry&& entry) {
+        entries.push_back(std::move(entry));
+        return Lazy<F>(this, entries.size() - 1);
+    }
+
+    void check_owned(const Lazy<F>& value) const {
+        if (&value.graph() != this)
+            throw std::runtime_error(GRAPH_MISMATCH_ERR_MSG);
+    }
+
+    static std::vector<bool>
+    mark_live(const std::vector<Entry>& graph, const std::vector<size_t>& roots) {
+        std::vector<bool> live(graph.size(), false);
+        for (size_t root : roots)
+            live[root] = true;
+        for (size_t id = graph.size(); id-- > 0;) {
+            if (live[id]) {
+                for (size_t input : graph[id].inputs)
+                    live[input] = true;
+            }
+        }
+        return live;
+    }
+
+    static bool is_constant(const Entry& entry, const F& value) {
+        if constexpr (std::equality_comparable<F>)
+            return entry.kind == Kind::CONSTANT && entry.value->data() == value;
+        else
+            return false;
+    }
+
+    static std::optional<size_t>
+    simplify(const Entry& entry, const std::vector<Entry>& plan) {
+        const F one = FieldTraits<F>::one;
+        const F zero = one - one;
+        const std::vector<size_t>& in = entry.inputs;
+        if (entry.op == typeid(Identity<F>))
+            return in[0];
+        if (entry.op == typeid(Add<F>)) {
+            if (is_constant(plan[in[1]], zero))
+                return in[0];
+            if (is_constant(plan[in[0]], zero))
+                return in[1];
+        }
+        if (entry.op == typeid(Subtract<F>) && is_constant(plan[in[1]], zero))
+            return in[0];
+        if (entry.op == typeid(Mul<F>)) {
+            if (is_constant(plan[in[1]], one))
+                return in[0];
+            if (is_constant(plan[in[0]], one))
+                return in[1];
+        }
+        if (entry.op == typeid(Div<F>) && is_constant(plan[in[1]], one))
+            return in[0];
+        if (entry.op == typeid(Pow<F>) && entry.scalar == 1.0)
+            return in[0];
+        const Entry& inner = plan[in[0]];
+        if (entry.inverse_of != typeid(void) && inner.kind == Kind::OP
+            && inner.op == entry.inverse_of)
+            return inner.inputs[0];
+        return std::nullopt;
+    }
+
+    static std::vector<AutoGrad<F>>
+    arguments(const Entry& entry, const std::vector<Entry>& plan) {
+        std::vector<AutoGrad<F>> args;
+        args.reserve(entry.inputs.size());
+        for (size_t input : entry.inputs)
+            args.push_back(*plan[input].value);
+        return args;
+    }
+
+   public:
+    LazyGraph() = default;
+
+    LazyGraph(const LazyGraph&) = delete;
+
+    LazyGraph& operator=(const LazyGraph&) = delete;
+
+    template <typename Op>
+    static Lazy<F> record(
+        std::span<const Lazy<F>> args,
+        Executor execute,
+        std::optional<double> scalar = std::nullopt
+    ) {
+        if (args.empty())
+            throw std::runtime_error(NO_ARGS_ERR_MSG);
+        LazyGraph& graph = args[0].graph();
+        Entry entry{Kind::OP};
+        if (scalar)
+            entry.form = Form::SCALAR;
+        else if (std::is_base_of_v<Function<F, Op>, Op>)
+            entry.form = Form::UNARY;
+        else if (std::is_base_of_v<BiFunction<F, Op>, Op>)
+            entry.form = Form::BINARY;
+        else if (std::is_base_of_v<VariadicFunction<F, Op>, Op>)
+            entry.form = Form::VARIADIC;
+        else
+            entry.form = Form::MULTI;
+        entry.op = typeid(Op);
+        entry.inverse_of = typeid(typename InverseTraits<Op>::inverse_of);
+        entry.name = OpName<Op>::name();
+        for (const Lazy<F>& arg : args) {
+            graph.check_owned(arg);
+            entry.inputs.push_back(arg.id());
+        }
+        entry.scalar = scalar;
+        entry.execute = std::move(execute);
+        return graph.push(std::move(entry));
+    }
+
+    // Inputs are numbered in the order they are added.
+    Lazy<F> input(const AutoGrad<F>& value) {
+        Entry entry = value_entry(Kind::INPUT, value);
+        entry.index = inputs_count++;
+        return push(std::move(entry));
+    }
+
+    Lazy<F> constant(const F& value) {
+        return push(value_entry(Kind::CONSTANT, AutoGrad<F>(value)));
+    }
+
+    Plan optimize(std::span<const Lazy<F>> outputs) {
+        _stats = LazyStats();
+        std::vector<size_t> roots;
+        for (const Lazy<F>& output : outputs) {
+            check_owned(output);
+            roots.push_back(output.id());
+        }
+
+        std::vector<bool> reachable = mark_live(entries, roots);
+        std::vector<Entry> plan;
+        std::vector<size_t> remap(entries.size());
+        std::map<Key, size_t> seen;
+        for (size_t id = 0; id < entries.size(); id++) {
+            const Entry& entry = entries[id];
+            if (entry.kind == Kind::OP)
+                _stats.recorded++;
+            if (!reachable[id]) {
+                if (entry.kind == Kind::OP)
+                    _stats.removed++;
+                continue;
+            }
+            if (entry.kind != Kind::OP) {
+                remap[id] = plan.size();
+                plan.push_back(entry);
+                continue;
+            }
+            Entry op = entry;
+            for (size_t& input : op.inputs)
+                input = remap[input];
+            if (std::all_of(op.inputs.begin(), op.inputs.end(), [&](size_t input) {
+                    return plan[input].kind == Kind::CONSTANT;
+                })) {
+                AutoGrad<F> folded = op.execute(arguments(op, plan));
+                remap[id] = plan.size();
+                plan.push_back(value_entry(Kind::CONSTANT, folded));
+                _stats.folded++;
+            } else if (std::optional<size_t> simpler = simplify(op, plan)) {
+                remap[id] = *simpler;
+                _stats.simplified++;
+            } else {
+                Key key(op.op, op.inputs, op.scalar);
+                auto it = seen.find(key);
+                if (it != seen.end()) {
+                    remap[id] = it->second;
+                    _stats.merged++;
+                } else {
+                    remap[id] = plan.size();
+                    seen.emplace(std::move(key), plan.size());
+                    plan.push_back(std::move(op));
+                }
+            }
+        }
+
+        for (size_t& root : roots)
+            root = remap[root];
+        std::vector<bool> live = mark_live(plan, roots);
+        for (size_t id = 0; id < plan.size(); id++) {
+            if (plan[id].kind == Kind::OP && !live[id])
+                _stats.removed++;
+        }
+        return Plan{std::move(plan), std::move(live), std::move(roots)};
+    }
+
+    std::vector<AutoGrad<F>> evaluate(std::span<const Lazy<F>> outputs) {
+        Plan plan = optimize(outputs);
+        for (size_t id = 0; id < plan.entries.size(); id++) {
+            Entry& entry = plan.entries[id];
+            if (entry.kind == Kind::OP && plan.live[id]) {
+                entry.value = entry.execute(arguments(entry, plan.entries));
+                _stats.executed++;
+            }
+        }
+
+        std::vector<AutoGrad<F>> result;
+        result.reserve(plan.roots.size());
+        for (size_t root : plan.roots)
+            result.push_back(*plan.entries[root].value);
+        return result;
+    }
+
+    AutoGrad<F> evaluate(const Lazy<F>& output) {
+        return evaluate(std::span<const Lazy<F>>(&output, 1))[0];
+    }
+
+    [[nodiscard]] size_t input_count() const { return inputs_count; }
+
+    [[nodiscard]] const LazyStats& stats() const { return _stats; }
+};
+
+template <Field F>
+Lazy<F> operator+(const Lazy<F>& x, const Lazy<F>& y) {
+    return Add<F>::call(x, y);
+}
+
+template <Field F>
+Lazy<F> operator-(const Lazy<F>& x, const Lazy<F>& y) {
+    return Subtract<F>::call(x, y);
+}
+
+template <Field F>
+Lazy<F> operator*(const Lazy<F>& x, const Lazy<F>& y) {
+    return Mul<F>::call(x, y);
+}
+
+template <Field F>
+Lazy<F> operator/(const Lazy<F>& x, const Lazy<F>& y) {
+    return Div<F>::call(x, y);
+}
+
+template <Field F>
+Lazy<F> operator-(const Lazy<F>& x) {
+    return FlipSign<F>::call(x);
+}
+}  // namespace autograd
+
+#endif  // LAZY_H
@@ -0,0 +1,46 @@
+#ifndef NODE_PTR_H
+#define NODE_PTR_H
+
+#include <memory>
+#include <utility>
+
+#ifdef AUTOGRAD_INTRUSIVE_REFCOUNT
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#endif
+
+#include "concepts.h"
+
+namespace autograd {
+template <Field F>
+class Node;
+
+// Graph nodes are owned through NodePtr. By default it is std::shared_ptr.
+// Defining AUTOGRAD_INTRUSIVE_REFCOUNT stores a non-atomic reference count
+// inside every node instead, which is faster but not thread-safe.
+#ifdef AUTOGRAD_INTRUSIVE_REFCOUNT
+template <Field F>
+using NodeBase = boost::intrusive_ref_counter<Node<F>, boost::thread_unsafe_counter>;
+
+template <Field F>
+using NodePtr = boost::intrusive_ptr<Node<F>>;
+
+template <Field F, typename... Args>
+NodePtr<F> make_node(Args&&... args) {
+    return NodePtr<F>(new Node<F>(std::forward<Args>(args)...));
+}
+#else
+template <Field F>
+class NodeBase {};
+
+template <Field F>
+using NodePtr = std::shared_ptr<Node<F>>;
+
+template <Field F, typename... Args>
+NodePtr<F> make_node(Args&&... args) {
+    return std::make_shared<Node<F>>(std::forward<Args>(args)...);
+}
+#endif
+}  // namespace autograd
+
+#endif  // NODE_PTR_H
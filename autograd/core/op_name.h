@@ -0,0 +1,44 @@
+#ifndef OP_NAME_H
+#define OP_NAME_H
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <typeindex>
+
+namespace autograd {
+inline std::string demangle(const std::type_index type) {
+    int status = 0;
+    std::unique_ptr<char, decltype(&std::free)> name(
+        abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), &std::free
+    );
+    return status == 0 ? std::string(name.get()) : std::string(type.name());
+}
+
+// How generated source spells Op. The default uses the demangled name when it is
+// valid source, which rules out e.g. anonymous namespaces and floating point
+// template arguments; specialize it for such ops.
+template <typename Op>
+class OpName {
+    static std::optional<std::string> spellable(std::string name) {
+        const bool valid = std::all_of(name.begin(), name.end(), [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c))
+                || std::string("_:<>, ").find(c) != std::string::npos;
+        });
+        return valid ? std::optional(std::move(name)) : std::nullopt;
+    }
+
+   public:
+    static const std::optional<std::string>& name() {
+        static const std::optional<std::string> name = spellable(demangle(typeid(Op)));
+        return name;
+    }
+};
+}  // namespace autograd
+
+#endif  // OP_NAME_H
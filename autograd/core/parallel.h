@@ -0,0 +1,137 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "autograd.h"
+#include "concepts.h"
+#include "graph.h"
+
+namespace autograd {
+// Data-parallel gradient of a loss summed over a batch. The batch is split
+// across worker threads; each one builds and backwards its own graphs against
+// private replicas of the parameters, so no node is shared between threads.
+// The per-thread gradients are then summed pairwise in a tree and added to the
+// parameters' grads. The loss function runs concurrently and must only share
+// the parameters it is given with other threads.
+template <Field F, typename Sample>
+class DataParallel {
+   public:
+    typedef std::function<AutoGrad<F>(std::span<const AutoGrad<F>>, const Sample&)>
+        LossFunc;
+
+   private:
+    typedef grad_t<F> GradType;
+
+    constexpr static auto THREADS_ERR_MSG =
+        "autograd::DataParallel needs at least one thread.";
+    constexpr static auto PARAM_ERR_MSG =
+        "autograd::DataParallel parameters must be leaves.";
+
+    size_t threads;
+    LossFunc loss;
+
+    class Worker {
+       public:
+        std::vector<GradType> grads;
+        F loss{};
+        std::exception_ptr error = nullptr;
+        std::promise<void> reduced;
+    };
+
+    void compute(
+        Worker& worker,
+        std::span<const AutoGrad<F>> params,
+        std::span<const Sample> samples
+    ) const {
+        const GradType one = FieldTraits<GradType>::one;
+        worker.grads.assign(params.size(), one - one);
+        if (samples.empty())
+            return;
+        std::vector<AutoGrad<F>> replicas;
+        replicas.reserve(params.size());
+        for (const AutoGrad<F>& param : params)
+            replicas.push_back(param.copy(param.requires_grad()));
+        for (size_t i = 0; i < samples.size(); i++) {
+            AutoGrad<F> sample_loss = loss(replicas, samples[i]);
+            const F& value = sample_loss.data();
+            worker.loss = i == 0 ? value : worker.loss + value;
+            if (sample_loss.requires_grad())
+                sample_loss.backward();
+        }
+        for (size_t j = 0; j < replicas.size(); j++) {
+            if (replicas[j].has_grad())
+                worker.grads[j] = replicas[j].grad();
+        }
+    }
+
+    // Level by level, worker i adds in the buffer of worker i + step once that
+    // one has reduced its own subtree.
+    static void reduce(std::vector<Worker>& workers, size_t id) {
+        Worker& target = workers[id];
+        for (size_t step = 1; id % (2 * step) == 0 && id + step < workers.size();
+             step *= 2) {
+            Worker& source = workers[id + step];
+            source.reduced.get_future().wait();
+            for (size_t j = 0; j < target.grads.size(); j++)
+                target.grads[j] += source.grads[j];
+            target.loss += source.loss;
+        }
+        target.reduced.set_value();
+    }
+
+   public:
+    DataParallel(size_t threads, LossFunc loss)
+        : threads(threads), loss(std::move(loss)) {
+        if (threads == 0)
+            throw std::runtime_error(THREADS_ERR_MSG);
+    }
+
+    // Adds the gradient of the summed loss to the parameters' grads and returns
+    // the summed loss. Worker exceptions are rethrown here.
+    F backward(std::span<const AutoGrad<F>> params, std::span<const Sample> batch) {
+        for (const AutoGrad<F>& param : params) {
+            if (!param.get_node()->is_leaf())
+                throw std::runtime_error(PARAM_ERR_MSG);
+        }
+        const size_t count = std::max<size_t>(1, std::min(threads, batch.size()));
+        std::vector<Worker> workers(count);
+        auto work = [&](size_t id) {
+            const size_t begin = batch.size() * id / count;
+            const size_t end = batch.size() * (id + 1) / count;
+            try {
+                compute(workers[id], params, batch.subspan(begin, end - begin));
+            } catch (...) {
+                workers[id].error = std::current_exception();
+            }
+            reduce(workers, id);
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(count - 1);
+        for (size_t id = 1; id < count; id++)
+            pool.emplace_back(work, id);
+        work(0);
+        for (std::thread& thread : pool)
+            thread.join();
+
+        for (const Worker& worker : workers) {
+            if (worker.error)
+                std::rethrow_exception(worker.error);
+        }
+        for (size_t j = 0; j < params.size(); j++) {
+            if (params[j].requires_grad())
+                params[j].get_node()->accumulate_grad(workers[0].grads[j]);
+        }
+        return workers[0].loss;
+    }
+};
+}  // namespace autograd
+
+#endif  // PARALLEL_H
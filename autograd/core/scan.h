@@ -0,0 +1,90 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "autograd.h"
+#include "concepts.h"
+
+namespace autograd {
+// Runs a recurrence x_{t+1} = step(x_t, params) for a number of steps and
+// records it as a single node with edges to x_0 and the params. The step is
+// called with Value<F> arguments on the forward pass, and only the states are
+// kept. Backward walks the steps in reverse, calling the step with Dual<F>
+// arguments to get its local derivatives, so no node is built for any step.
+template <Field F>
+class Scan : public VariadicFunction<F, Scan<F>> {
+    typedef grad_t<F> GradType;
+
+    // Derivatives of x_T with respect to x_0 and each param.
+    template <typename Step>
+    static void backward(
+        const Step& step,
+        const std::vector<F>& states,
+        std::span<const F> args,
+        std::span<F> grad
+    ) {
+        const GradType one = FieldTraits<GradType>::one;
+        std::vector<Dual<F>> params;
+        params.reserve(args.size() - 1);
+        for (size_t j = 1; j < args.size(); j++)
+            params.push_back(Dual<F>::variable(args[j], j, args.size()));
+
+        GradType adjoint = one;
+        std::vector<GradType> param_grads(params.size(), one - one);
+        for (size_t t = states.size() - 1; t-- > 0;) {
+            const Dual<F> x = Dual<F>::variable(states[t], 0, args.size());
+            Dual<F> next = step(x, std::span(std::as_const(params)));
+            for (size_t j = 0; j < params.size(); j++)
+                param_grads[j] += adjoint * next.tangent(j + 1);
+            adjoint = adjoint * next.tangent(0);
+        }
+
+        grad[0] = static_cast<F>(adjoint);
+        for (size_t j = 0; j < params.size(); j++)
+            grad[j + 1] = static_cast<F>(param_grads[j]);
+    }
+
+   public:
+    // step(x, params) must accept both Value<F> and Dual<F> arguments, e.g.
+    //   [](const auto& x, auto params) { return Tanh::call(params[0] * x); }
+    template <typename Step>
+    static AutoGrad<F> call(
+        Step step,
+        const AutoGrad<F>& x0,
+        std::span<const AutoGrad<F>> params,
+        const size_t steps
+    ) {
+        std::vector<Value<F>> values;
+        values.reserve(params.size());
+        for (const AutoGrad<F>& param : params)
+            values.emplace_back(param.data());
+        std::vector<F> states;
+        states.reserve(steps + 1);
+        states.push_back(x0.data());
+        for (size_t t = 0; t < steps; t++) {
+            Value<F> x(states.back());
+            Value<F> next = step(std::as_const(x), std::span(std::as_const(values)));
+            states.push_back(next.data());
+        }
+
+        std::vector<AutoGrad<F>> args;
+        args.reserve(params.size() + 1);
+        args.push_back(x0);
+        args.insert(args.end(), params.begin(), params.end());
+        F result = states.back();
+        typedef std::span<const F> Args;
+        return VariadicFunction<F, Scan<F>>::make_result(
+            args,
+            std::move(result),
+            [step, states = std::move(states)](Args x, std::span<F> grad) {
+                backward(step, states, x, grad);
+            }
+        );
+    }
+};
+}  // namespace autograd
+
+#endif  // SCAN_H
@@ -0,0 +1,117 @@
+#ifndef SPARSE_TABLE_H
+#define SPARSE_TABLE_H
+
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "autograd.h"
+#include "concepts.h"
+
+namespace autograd {
+template <Field F>
+class SparseGrad {
+   public:
+    std::vector<size_t> indices;
+    std::vector<grad_t<F>> values;
+
+    [[nodiscard]] size_t size() const { return indices.size(); }
+};
+
+// Table of parameters stored as plain values. lookup() creates a leaf only for
+// the rows a step uses, so gradients, updates and resets cost time
+// proportional to the touched rows rather than to the table size.
+template <Field F>
+class SparseTable {
+   public:
+    typedef grad_t<F> GradType;
+    typedef std::function<void(size_t, F&, const GradType&)> UpdateFunc;
+
+   private:
+    constexpr static auto INDEX_ERR_MSG = "autograd::SparseTable index out of range.";
+
+    std::vector<F> _values;
+    std::unordered_map<size_t, size_t> slots;
+    std::vector<size_t> rows;
+    std::vector<AutoGrad<F>> leaves;
+
+   public:
+    explicit SparseTable(std::vector<F> values) : _values(std::move(values)) {}
+
+    SparseTable(size_t size, const F& value) : _values(size, value) {}
+
+    // Looking a row up again in the same step returns the same leaf.
+    AutoGrad<F> lookup(size_t row) {
+        if (row >= _values.size())
+            throw std::runtime_error(INDEX_ERR_MSG);
+        auto [slot, inserted] = slots.try_emplace(row, leaves.size());
+        if (inserted) {
+            rows.push_back(row);
+            leaves.emplace_back(_values[row], true);
+        }
+        return leaves[slot->second];
+    }
+
+    std::vector<AutoGrad<F>> lookup(std::span<const size_t> indices) {
+        std::vector<AutoGrad<F>> result;
+        result.reserve(indices.size());
+        for (size_t row : indices)
+            result.push_back(lookup(row));
+        return result;
+    }
+
+    // Gradients of the rows looked up since the last update, in lookup order.
+    [[nodiscard]] SparseGrad<F> sparse_grad() const {
+        SparseGrad<F> result;
+        for (size_t i = 0; i < leaves.size(); i++) {
+            if (leaves[i].has_grad()) {
+                result.indices.push_back(rows[i]);
+                result.values.push_back(leaves[i].grad());
+            }
+        }
+        return result;
+    }
+
+    // Calls update(row, value, grad) for every touched row with a gradient and
+    // starts a new step.
+    void update(const UpdateFunc& update) {
+        for (size_t i = 0; i < leaves.size(); i++) {
+            if (leaves[i].has_grad())
+                update(rows[i], _values[rows[i]], leaves[i].grad());
+        }
+        zero_grad();
+    }
+
+    // Drops the leaves of the current step, along with their gradients.
+    void zero_grad() {
+        slots.clear();
+        rows.clear();
+        leaves.clear();
+    }
+
+    [[nodiscard]] size_t size() const { return _values.size(); }
+
+    [[nodiscard]] size_t touched() const { return rows.size(); }
+
+    [[nodiscard]] const F& value(size_t row) const { return _values.at(row); }
+};
+
+template <Field F>
+class SparseSGD {
+    grad_t<F> learning_rate;
+
+   public:
+    explicit SparseSGD(const grad_t<F>& learning_rate) : learning_rate(learning_rate) {}
+
+    void step(SparseTable<F>& table) const {
+        table.update([this](size_t, F& value, const grad_t<F>& grad) {
+            value = static_cast<F>(value - learning_rate * grad);
+        });
+    }
+};
+}  // namespace autograd
+
+#endif  // SPARSE_TABLE_H
@@ -0,0 +1,220 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "mapped_file.h"
+
+namespace autograd {
+// Layout of a columnar file: this header, then every column stored as `rows`
+// contiguous values, one column after another.
+class ColumnarHeader {
+   public:
+    constexpr static char MAGIC[8] = {'A', 'G', 'C', 'O', 'L', 'U', 'M', 'N'};
+    constexpr static uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t value_size;
+    uint64_t rows;
+    uint64_t cols;
+};
+
+template <Field F>
+void write_columnar(const std::string& path, std::span<const std::vector<F>> columns) {
+    static_assert(std::is_trivially_copyable_v<F>);
+    ColumnarHeader header{};
+    std::memcpy(header.magic, ColumnarHeader::MAGIC, sizeof(header.magic));
+    header.version = ColumnarHeader::VERSION;
+    header.value_size = sizeof(F);
+    header.rows = columns.empty() ? 0 : columns[0].size();
+    header.cols = columns.size();
+    for (const std::vector<F>& column : columns) {
+        if (column.size() != header.rows)
+            throw std::runtime_error("All columns must have the same length.");
+    }
+    write_replacing(path, [&](std::ofstream& out) {
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const std::vector<F>& column : columns)
+            out.write(
+                reinterpret_cast<const char*>(column.data()),
+                static_cast<std::streamsize>(column.size() * sizeof(F))
+            );
+    });
+}
+
+// Memory-mapped columnar file. Values are read straight from the mapping.
+template <Field F>
+class ColumnarDataset {
+    static_assert(std::is_trivially_copyable_v<F>);
+    constexpr static auto FORMAT_ERR_MSG = "Not a columnar dataset file: ";
+
+    MappedFile file;
+    ColumnarHeader header{};
+
+   public:
+    explicit ColumnarDataset(const std::string& path) : file(path) {
+        if (file.size() < sizeof(header))
+            throw std::runtime_error(FORMAT_ERR_MSG + path);
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, ColumnarHeader::MAGIC, sizeof(header.magic)) != 0
+            || header.version != ColumnarHeader::VERSION
+            || header.value_size != sizeof(F)
+            || file.size() != sizeof(header) + header.rows * header.cols * sizeof(F))
+            throw std::runtime_error(FORMAT_ERR_MSG + path);
+    }
+
+    [[nodiscard]] size_t rows() const { return header.rows; }
+
+    [[nodiscard]] size_t cols() const { return header.cols; }
+
+    [[nodiscard]] std::span<const F> column(size_t col) const {
+        const F* values = reinterpret_cast<const F*>(file.data() + sizeof(header));
+        return std::span<const F>(values + col * header.rows, header.rows);
+    }
+
+    void will_need(size_t first_row, size_t count) const {
+        for (size_t col = 0; col < cols(); col++)
+            file.will_need(
+                sizeof(header) + (col * header.rows + first_row) * sizeof(F),
+                count * sizeof(F)
+            );
+    }
+};
+
+// Streams mini-batches of a ColumnarDataset. A background thread pages in the
+// next `readahead` batches while the current one is used. Every column of a
+// batch is bound to the same leaves each time, so no nodes are allocated and
+// graphs built from a batch must be done with before calling next() again.
+template <Field F>
+class BatchStream {
+    constexpr static auto BATCH_SIZE_ERR_MSG =
+        "autograd::BatchStream needs a batch size of at least one.";
+
+    const ColumnarDataset<F>& dataset;
+    const size_t batch_size;
+    const size_t readahead;
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<std::vector<AutoGrad<F>>> leaves;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    size_t requested = 0;
+    bool stopping = false;
+    std::thread prefetcher;
+
+    // Checked before the prefetcher starts, which must not outlive a throw.
+    static size_t checked_batch_size(const size_t batch_size) {
+        if (batch_size == 0)
+            throw std::runtime_error(BATCH_SIZE_ERR_MSG);
+        return batch_size;
+    }
+
+    void prefetch_loop() {
+        size_t handled = 0;
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || requested != handled; });
+            if (stopping)
+                return;
+            const size_t first = requested;
+            lock.unlock();
+            const size_t count = readahead * batch_size;
+            dataset.will_need(first, count);
+            touch(first, count);
+            lock.lock();
+            handled = first;
+        }
+    }
+
+    // Faults the pages in on this thread instead of on the consumer's.
+    void touch(size_t first, size_t count) const {
+        constexpr size_t stride = 4096 / sizeof(F) + 1;
+        const size_t last = std::min(first + count, dataset.rows());
+        for (size_t col = 0; col < dataset.cols(); col++) {
+            std::span<const F> column = dataset.column(col);
+            for (size_t row = first; row < last; row += stride)
+                static_cast<void>(*static_cast<const volatile F*>(&column[row]));
+        }
+    }
+
+   public:
+    BatchStream(
+        const ColumnarDataset<F>& dataset,
+        size_t batch_size,
+        size_t readahead = 2
+    )
+        : dataset(dataset),
+          batch_size(checked_batch_size(batch_size)),
+          readahead(readahead),
+          leaves(dataset.cols()),
+          prefetcher(&BatchStream::prefetch_loop, this) {}
+
+    BatchStream(const BatchStream&) = delete;
+
+    BatchStream& operator=(const BatchStream&) = delete;
+
+    ~BatchStream() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        prefetcher.join();
+    }
+
+    // Moves to the next batch, returns false once the dataset is exhausted.
+    bool next() {
+        begin = end;
+        if (begin >= dataset.rows())
+            return false;
+        end = std::min(begin + batch_size, dataset.rows());
+        {
+            std::lock_guard lock(mutex);
+            requested = end;
+        }
+        wake.notify_one();
+        for (size_t col = 0; col < dataset.cols(); col++) {
+            std::span<const F> values = dataset.column(col).subspan(begin, size());
+            std::vector<AutoGrad<F>>& bound = leaves[col];
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i < bound.size())
+                    bound[i].data() = values[i];
+                else
+                    bound.emplace_back(values[i]);
+            }
+        }
+        return true;
+    }
+
+    void rewind() { begin = end = 0; }
+
+    [[nodiscard]] size_t size() const { return end - begin; }
+
+    [[nodiscard]] size_t first_row() const { return begin; }
+
+    // Leaves holding the current batch of a column.
+    [[nodiscard]] std::span<const AutoGrad<F>> column(size_t col) const {
+        return std::span<const AutoGrad<F>>(leaves[col]).first(size());
+    }
+
+    // The current batch of a column, read directly from the mapping.
+    [[nodiscard]] std::span<const F> values(size_t col) const {
+        return dataset.column(col).subspan(begin, size());
+    }
+};
+}  // namespace autograd
+
+#endif  // DATASET_H
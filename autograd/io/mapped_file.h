@@ -0,0 +1,108 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace autograd {
+// Read-only memory mapping of a whole file.
+class MappedFile {
+    void* _data = nullptr;
+    size_t _size = 0;
+
+    static std::runtime_error error(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+    }
+
+   public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw error("Cannot open", path);
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw error("Cannot stat", path);
+        }
+        _size = static_cast<size_t>(info.st_size);
+        if (_size > 0) {
+            _data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (_data == MAP_FAILED) {
+                ::close(fd);
+                throw error("Cannot map", path);
+            }
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    ~MappedFile() {
+        if (_data != nullptr)
+            ::munmap(_data, _size);
+    }
+
+    [[nodiscard]] const std::byte* data() const {
+        return static_cast<const std::byte*>(_data);
+    }
+
+    [[nodiscard]] size_t size() const { return _size; }
+
+    // Asks the kernel to start reading the given range in the background.
+    void will_need(size_t offset, size_t length) const {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = offset / page * page;
+        if (_data == nullptr || begin >= _size)
+            return;
+        length = std::min(offset + length, _size) - begin;
+        ::madvise(static_cast<std::byte*>(_data) + begin, length, MADV_WILLNEED);
+    }
+};
+
+// Writes to a temporary file next to path, then renames it over path. Existing
+// mappings keep the old file and readers never see a partial one.
+template <typename Writer>
+void write_replacing(const std::string& path, Writer writer) {
+    const std::string temp = path + ".tmp";
+    try {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        writer(out);
+        out.close();
+        if (!out)
+            throw std::runtime_error("Cannot write '" + temp + "'.");
+        if (std::rename(temp.c_str(), path.c_str()) != 0)
+            throw std::runtime_error(
+                "Cannot replace '" + path + "': " + std::strerror(errno)
+            );
+    } catch (...) {
+        std::remove(temp.c_str());
+        throw;
+    }
+}
+}  // namespace autograd
+
+#endif  // MAPPED_FILE_H
@@ -0,0 +1,195 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "mapped_file.h"
+
+namespace autograd {
+// Layout of a snapshot file: this header, then `count` values, padded to the
+// alignment of the grad type, then `count` grads if HAS_GRADS is set, then
+// `states` arrays of `count` grad values each.
+class SnapshotHeader {
+   public:
+    constexpr static char MAGIC[8] = {'A', 'G', 'S', 'N', 'A', 'P', 'S', 'H'};
+    constexpr static uint32_t VERSION = 2;
+    constexpr static uint32_t HAS_GRADS = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t value_size;
+    uint32_t grad_size;
+    uint32_t flags;
+    uint64_t count;
+    uint64_t states;
+};
+
+// Binary snapshot of leaf values, optionally with their grads and extra
+// per-parameter state such as optimizer moments. Loading maps the file, so
+// the arrays are read in place and only the pages actually used are loaded.
+template <Field F>
+class Snapshot {
+    typedef grad_t<F> GradType;
+    static_assert(std::is_trivially_copyable_v<F>);
+    static_assert(std::is_trivially_copyable_v<GradType>);
+
+    constexpr static auto FORMAT_ERR_MSG = "Not a snapshot file: ";
+    constexpr static auto SIZE_ERR_MSG = "Snapshot arrays must match the parameters.";
+    constexpr static auto LEAF_ERR_MSG = "Only leaf values can be restored.";
+
+    MappedFile file;
+    SnapshotHeader header{};
+
+    // Grad arrays start aligned, since values may be narrower than grads.
+    static size_t grads_offset(const size_t count) {
+        const size_t end = sizeof(SnapshotHeader) + count * sizeof(F);
+        return (end + alignof(GradType) - 1) / alignof(GradType) * alignof(GradType);
+    }
+
+    [[nodiscard]] size_t grads_offset() const { return grads_offset(header.count); }
+
+    [[nodiscard]] size_t state_offset(size_t index) const {
+        const size_t grads = has_grads() ? header.count * sizeof(GradType) : 0;
+        return grads_offset() + grads + index * header.count * sizeof(GradType);
+    }
+
+    template <typename T>
+    static void write(std::ofstream& out, std::span<const T> values) {
+        out.write(
+            reinterpret_cast<const char*>(values.data()),
+            static_cast<std::streamsize>(values.size_bytes())
+        );
+    }
+
+   public:
+    explicit Snapshot(const std::string& path) : file(path) {
+        if (file.size() < sizeof(header))
+            throw std::runtime_error(FORMAT_ERR_MSG + path);
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, SnapshotHeader::MAGIC, sizeof(header.magic)) != 0
+            || header.version != SnapshotHeader::VERSION
+            || header.value_size != sizeof(F)
+            || header.grad_size != sizeof(GradType)
+            || file.size() != state_offset(header.states))
+            throw std::runtime_error(FORMAT_ERR_MSG + path);
+    }
+
+    // Params without a gradient are saved with a zero one. Snapshots already
+    // mapped from path keep reading the previous file.
+    static void save(
+        const std::string& path,
+        std::span<const AutoGrad<F>> params,
+        bool with_grads = false,
+        std::span<const std::vector<GradType>> states = {}
+    ) {
+        SnapshotHeader header{};
+        std::memcpy(header.magic, SnapshotHeader::MAGIC, sizeof(header.magic));
+        header.version = SnapshotHeader::VERSION;
+        header.value_size = sizeof(F);
+        header.grad_size = sizeof(GradType);
+        header.flags = with_grads ? SnapshotHeader::HAS_GRADS : 0;
+        header.count = params.size();
+        header.states = states.size();
+        for (const std::vector<GradType>& state : states) {
+            if (state.size() != params.size())
+                throw std::runtime_error(SIZE_ERR_MSG);
+        }
+
+        std::vector<F> values;
+        values.reserve(params.size());
+        for (const AutoGrad<F>& param : params)
+            values.push_back(param.data());
+        std::vector<GradType> grads;
+        if (with_grads) {
+            const GradType one = FieldTraits<GradType>::one;
+            grads.reserve(params.size());
+            for (const AutoGrad<F>& param : params) {
+                const Node<F>* node = param.get_node();
+                grads.push_back(node->has_grad() ? node->get_grad() : one - one);
+            }
+        }
+        const std::vector<char> padding(
+            grads_offset(params.size()) - sizeof(header) - values.size() * sizeof(F), 0
+        );
+        write_replacing(path, [&](std::ofstream& out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            write<F>(out, values);
+            write<char>(out, padding);
+            write<GradType>(out, grads);
+            for (const std::vector<GradType>& state : states)
+                write<GradType>(out, state);
+        });
+    }
+
+    [[nodiscard]] size_t size() const { return header.count; }
+
+    [[nodiscard]] bool has_grads() const {
+        return (header.flags & SnapshotHeader::HAS_GRADS) != 0;
+    }
+
+    [[nodiscard]] size_t state_count() const { return header.states; }
+
+    [[nodiscard]] std::span<const F> values() const {
+        return std::span<const F>(
+            reinterpret_cast<const F*>(file.data() + sizeof(header)), header.count
+        );
+    }
+
+    [[nodiscard]] std::span<const GradType> grads() const {
+        if (!has_grads())
+            return {};
+        return std::span<const GradType>(
+            reinterpret_cast<const GradType*>(file.data() + grads_offset()),
+            header.count
+        );
+    }
+
+    [[nodiscard]] std::span<const GradType> state(size_t index) const {
+        return std::span<const GradType>(
+            reinterpret_cast<const GradType*>(file.data() + state_offset(index)),
+            header.count
+        );
+    }
+
+    // Writes the saved values, and grads if present, into existing leaves.
+    // Nothing is written unless every param is a leaf.
+    void restore(std::span<const AutoGrad<F>> params) const {
+        if (params.size() != size())
+            throw std::runtime_error(SIZE_ERR_MSG);
+        std::span<const F> saved_values = values();
+        std::span<const GradType> saved_grads = grads();
+        for (const AutoGrad<F>& param : params) {
+            if (!param.get_node()->is_leaf())
+                throw std::runtime_error(LEAF_ERR_MSG);
+        }
+        for (size_t i = 0; i < params.size(); i++) {
+            Node<F>* node = params[i].get_node();
+            node->data() = saved_values[i];
+            if (has_grads()) {
+                node->clear_grad();
+                node->accumulate_grad(saved_grads[i]);
+            }
+        }
+    }
+
+    // Fresh leaves holding the saved values and grads.
+    [[nodiscard]] std::vector<AutoGrad<F>> load(bool requires_grad = true) const {
+        std::vector<AutoGrad<F>> params;
+        params.reserve(size());
+        for (const F& value : values())
+            params.emplace_back(value, requires_grad);
+        restore(params);
+        return params;
+    }
+};
+}  // namespace autograd
+
+#endif  // SNAPSHOT_H
@@ -1,43 +1,57 @@
 #ifndef ACTIVATIONS_H
 #define ACTIVATIONS_H
 
-#include "cmath"
+#include <cmath>
+#include <concepts>
 
 #include "autograd/core/autograd.h"
+#include "autograd/real/real_function.h"
 
 namespace autograd {
-class Tanh : public Function<double, Tanh> {
+class Tanh : public RealFunction<Tanh> {
    public:
-    static double forward(double x) { return std::tanh(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::tanh(x); }
 
-    static double backward(double x) {
-        const double cosh = std::cosh(x);
-        return 1.0 / (cosh * cosh);
+    template <std::floating_point T>
+    static T backward(T x) {
+        const T cosh = std::cosh(x);
+        return T(1) / (cosh * cosh);
     }
 };
 
-class Sigmoid : public Function<double, Sigmoid> {
+class Sigmoid : public RealFunction<Sigmoid> {
    public:
-    static double forward(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+    template <std::floating_point T>
+    static T forward(T x) { return T(1) / (T(1) + std::exp(-x)); }
 
-    static double backward(double x) {
-        const double ex = std::exp(x);
-        return ex / ((ex + 1) * (ex + 1));
+    template <std::floating_point T>
+    static T backward(T x) {
+        const T ex = std::exp(x);
+        return ex / ((ex + T(1)) * (ex + T(1)));
     }
 };
 
-class ReLU : public Function<double, ReLU> {
+class ReLU : public RealFunction<ReLU> {
    public:
-    static double forward(double x) { return (x >= 0) ? x : 0; }
+    template <std::floating_point T>
+    static T forward(T x) { return (x >= 0) ? x : T(0); }
 
-    static double backward(double x) { return (x > 0) ? 1 : 0; }
+    template <std::floating_point T>
+    static T backward(T x) { return (x > 0) ? T(1) : T(0); }
 };
 
-class LeakyReLU : public ScalarFunction<double, double, LeakyReLU> {
+class LeakyReLU : public RealScalarFunction<double, LeakyReLU> {
    public:
-    static double forward(double x, double slope) { return (x >= 0) ? x : slope * x; }
+    template <std::floating_point T>
+    static T forward(T x, double slope) {
+        return (x >= 0) ? x : static_cast<T>(slope) * x;
+    }
 
-    static double backward(double x, double slope) { return (x > 0) ? 1 : slope; }
+    template <std::floating_point T>
+    static T backward(T x, double slope) {
+        return (x > 0) ? T(1) : static_cast<T>(slope);
+    }
 };
 
 }  // namespace autograd
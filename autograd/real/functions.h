@@ -1,67 +1,106 @@
 #ifndef FUNCTIONS_H
 #define FUNCTIONS_H
 
+#include <array>
 #include <cmath>
+#include <concepts>
+#include <sstream>
+#include <string>
 
 #include "autograd/core/autograd.h"
+#include "autograd/core/op_name.h"
+#include "autograd/real/real_function.h"
 
 namespace autograd {
-class Sqrt : public Function<double, Sqrt> {
+class Sqrt : public RealFunction<Sqrt> {
    public:
-    static double forward(double x) { return std::sqrt(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::sqrt(x); }
 
-    static double backward(double x) { return 1.0 / (2.0 * std::sqrt(x)); }
+    template <std::floating_point T>
+    static T backward(T x) { return T(1) / (T(2) * std::sqrt(x)); }
 };
 
-class Exp : public Function<double, Exp> {
+class Exp : public RealFunction<Exp> {
    public:
-    static double forward(double x) { return std::exp(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::exp(x); }
 
-    static double backward(double x) { return std::exp(x); }
+    template <std::floating_point T>
+    static T backward(T x) { return std::exp(x); }
 };
 
-class Ln : public Function<double, Ln> {
+class Ln : public RealFunction<Ln> {
    public:
-    static double forward(double x) { return std::log(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::log(x); }
 
-    static double backward(double x) { return 1.0 / x; }
+    template <std::floating_point T>
+    static T backward(T x) { return T(1) / x; }
+};
+
+template <>
+class InverseTraits<Ln> {
+   public:
+    typedef Exp inverse_of;
 };
 
 template <double BASE>
-class Log : public Function<double, Log<BASE>> {
+class Log : public RealFunction<Log<BASE>> {
    public:
-    static double forward(double x) { return std::log(x) / std::log(BASE); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::log(x) / std::log(static_cast<T>(BASE)); }
+
+    template <std::floating_point T>
+    static T backward(T x) {
+        const T log_base = std::log(static_cast<T>(BASE));
+        return -std::log(x) / (static_cast<T>(BASE) * log_base * log_base);
+    }
+};
 
-    static double backward(double x) {
-        return -std::log(x) / (BASE * std::log(BASE) * std::log(BASE));
+// The demangled name spells BASE as raw bytes, a hexadecimal literal is exact.
+template <double BASE>
+class OpName<Log<BASE>> {
+   public:
+    static const std::optional<std::string>& name() {
+        static const std::optional<std::string> name = [] {
+            std::ostringstream stream;
+            stream << "autograd::Log<" << std::hexfloat << BASE << ">";
+            return stream.str();
+        }();
+        return name;
     }
 };
 
-class Abs : public Function<double, Abs> {
+class Abs : public RealFunction<Abs> {
    public:
-    static double forward(double x) { return std::abs(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::abs(x); }
 
-    static double backward(double x) {
+    template <std::floating_point T>
+    static T backward(T x) {
         if (x > 0)
-            return 1.0;
+            return T(1);
         if (x < 0)
-            return -1.0;
-        return 0.0;
+            return T(-1);
+        return T(0);
     }
 };
 
-class Distance : public MultiFunction<double, 4, Distance> {
+class Distance : public RealMultiFunction<4, Distance> {
    public:
-    static double forward(const std::array<double, 4>& args) {
-        const double dx = args[0] - args[2];
-        const double dy = args[1] - args[3];
+    template <std::floating_point T>
+    static T forward(const std::array<T, 4>& args) {
+        const T dx = args[0] - args[2];
+        const T dy = args[1] - args[3];
         return std::sqrt(dx * dx + dy * dy);
     }
 
-    static std::array<double, 4> backward(const std::array<double, 4>& args) {
-        const double dist = forward(args);
-        const double first = (args[0] - args[2]) / dist;
-        const double second = (args[1] - args[3]) / dist;
+    template <std::floating_point T>
+    static std::array<T, 4> backward(const std::array<T, 4>& args) {
+        const T dist = forward(args);
+        const T first = (args[0] - args[2]) / dist;
+        const T second = (args[1] - args[3]) / dist;
         return {first, second, -first, -second};
     }
 };
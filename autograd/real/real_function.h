@@ -0,0 +1,48 @@
+#ifndef REAL_FUNCTION_H
+#define REAL_FUNCTION_H
+
+#include "autograd/core/autograd.h"
+
+namespace autograd {
+// Bases for real ops, whose forward and backward are templates over
+// std::floating_point. Each op is then callable on both double and float graphs.
+template <typename Op>
+class RealFunction : public Function<double, Op>, public Function<float, Op> {
+   public:
+    using Function<double, Op>::call;
+    using Function<float, Op>::call;
+};
+
+template <typename Op>
+class RealBiFunction : public BiFunction<double, Op>, public BiFunction<float, Op> {
+   public:
+    using BiFunction<double, Op>::call;
+    using BiFunction<float, Op>::call;
+};
+
+template <int NUM_ARGS, typename Op>
+class RealMultiFunction : public MultiFunction<double, NUM_ARGS, Op>,
+                          public MultiFunction<float, NUM_ARGS, Op> {
+   public:
+    using MultiFunction<double, NUM_ARGS, Op>::call;
+    using MultiFunction<float, NUM_ARGS, Op>::call;
+};
+
+template <typename Op>
+class RealVariadicFunction : public VariadicFunction<double, Op>,
+                             public VariadicFunction<float, Op> {
+   public:
+    using VariadicFunction<double, Op>::call;
+    using VariadicFunction<float, Op>::call;
+};
+
+template <typename ScalarType, typename Op>
+class RealScalarFunction : public ScalarFunction<double, ScalarType, Op>,
+                           public ScalarFunction<float, ScalarType, Op> {
+   public:
+    using ScalarFunction<double, ScalarType, Op>::call;
+    using ScalarFunction<float, ScalarType, Op>::call;
+};
+}  // namespace autograd
+
+#endif  // REAL_FUNCTION_H
@@ -0,0 +1,177 @@
+#ifndef SOFTMAX_H
+#define SOFTMAX_H
+
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/real_function.h"
+
+namespace autograd {
+class LogSumExp : public RealVariadicFunction<LogSumExp> {
+   public:
+    // Returns the maximum and log(sum(exp(x - max))) in a single pass,
+    // rescaling the running sum whenever a new maximum is seen.
+    template <std::floating_point T>
+    static std::pair<T, T> shifted(std::span<const T> args) {
+        T max = args[0];
+        T sum = T(1);
+        for (size_t i = 1; i < args.size(); i++) {
+            if (args[i] > max) {
+                sum = sum * std::exp(max - args[i]) + T(1);
+                max = args[i];
+            } else {
+                sum += std::exp(args[i] - max);
+            }
+        }
+        return {max, std::log(sum)};
+    }
+
+    template <std::floating_point T>
+    static T forward(std::span<const T> args) {
+        const auto [max, log_sum] = shifted(args);
+        return max + log_sum;
+    }
+
+    template <std::floating_point T>
+    static void backward(std::span<const T> args, std::span<T> grad) {
+        const auto [max, log_sum] = shifted(args);
+        for (size_t i = 0; i < args.size(); i++)
+            grad[i] = std::exp(args[i] - max - log_sum);
+    }
+};
+
+// exp(x - y), used with y = LogSumExp(xs), where it never overflows.
+class ShiftedExp : public RealBiFunction<ShiftedExp> {
+   public:
+    template <std::floating_point T>
+    static T forward(T x, T y) { return std::exp(x - y); }
+
+    template <std::floating_point T>
+    static std::pair<T, T> backward(T x, T y) {
+        const T value = std::exp(x - y);
+        return {value, -value};
+    }
+};
+
+// Both return one output per input, each a single node on top of one shared
+// LogSumExp node.
+class Softmax {
+    template <typename T>
+    static std::vector<T> apply(std::span<const T> xs) {
+        const T lse = LogSumExp::call(xs);
+        std::vector<T> result;
+        result.reserve(xs.size());
+        for (const T& x : xs)
+            result.push_back(ShiftedExp::call(x, lse));
+        return result;
+    }
+
+   public:
+    static std::vector<AutoGrad<double>> call(std::span<const AutoGrad<double>> xs) {
+        return apply(xs);
+    }
+
+    static std::vector<AutoGrad<float>> call(std::span<const AutoGrad<float>> xs) {
+        return apply(xs);
+    }
+
+    static std::vector<Value<double>> call(std::span<const Value<double>> xs) {
+        return apply(xs);
+    }
+
+    static std::vector<Value<float>> call(std::span<const Value<float>> xs) {
+        return apply(xs);
+    }
+};
+
+class LogSoftmax {
+    template <typename T>
+    static std::vector<T> apply(std::span<const T> xs) {
+        const T lse = LogSumExp::call(xs);
+        std::vector<T> result;
+        result.reserve(xs.size());
+        for (const T& x : xs)
+            result.push_back(x - lse);
+        return result;
+    }
+
+   public:
+    static std::vector<AutoGrad<double>> call(std::span<const AutoGrad<double>> xs) {
+        return apply(xs);
+    }
+
+    static std::vector<AutoGrad<float>> call(std::span<const AutoGrad<float>> xs) {
+        return apply(xs);
+    }
+
+    static std::vector<Value<double>> call(std::span<const Value<double>> xs) {
+        return apply(xs);
+    }
+
+    static std::vector<Value<float>> call(std::span<const Value<float>> xs) {
+        return apply(xs);
+    }
+};
+
+// -log(softmax(logits)[target]) as a single node.
+class CrossEntropy : public RealVariadicFunction<CrossEntropy> {
+    constexpr static auto TARGET_ERR_MSG =
+        "autograd::CrossEntropy target is out of range.";
+
+    template <std::floating_point T>
+    static T forward(std::span<const T> logits, size_t target) {
+        if (target >= logits.size())
+            throw std::runtime_error(TARGET_ERR_MSG);
+        const auto [max, log_sum] = LogSumExp::shifted(logits);
+        return (max - logits[target]) + log_sum;
+    }
+
+    template <std::floating_point T>
+    static AutoGrad<T> apply(std::span<const AutoGrad<T>> logits, const size_t target) {
+        typedef VariadicFunction<T, CrossEntropy> Base;
+        const std::vector<T> args = Base::gather(logits);
+        return Base::make_result(
+            logits,
+            forward(std::span<const T>(args), target),
+            [target](std::span<const T> args, std::span<T> grad) {
+                LogSumExp::backward(args, grad);
+                grad[target] -= T(1);
+            }
+        );
+    }
+
+    template <std::floating_point T>
+    static Value<T> apply(std::span<const Value<T>> logits, const size_t target) {
+        const std::vector<T> args = VariadicFunction<T, CrossEntropy>::gather(logits);
+        return Value<T>(forward(std::span<const T>(args), target));
+    }
+
+   public:
+    static AutoGrad<double>
+    call(std::span<const AutoGrad<double>> logits, const size_t target) {
+        return apply(logits, target);
+    }
+
+    static AutoGrad<float>
+    call(std::span<const AutoGrad<float>> logits, const size_t target) {
+        return apply(logits, target);
+    }
+
+    static Value<double>
+    call(std::span<const Value<double>> logits, const size_t target) {
+        return apply(logits, target);
+    }
+
+    static Value<float>
+    call(std::span<const Value<float>> logits, const size_t target) {
+        return apply(logits, target);
+    }
+};
+}  // namespace autograd
+
+#endif  // SOFTMAX_H
@@ -2,63 +2,79 @@
 #define TRIGONOMETRIC_H
 
 #include <cmath>
+#include <concepts>
 
 #include "autograd/core/autograd.h"
+#include "autograd/real/real_function.h"
 
 namespace autograd {
-class Sin : public Function<double, Sin> {
+class Sin : public RealFunction<Sin> {
    public:
-    static double forward(double x) { return std::sin(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::sin(x); }
 
-    static double backward(double x) { return std::cos(x); }
+    template <std::floating_point T>
+    static T backward(T x) { return std::cos(x); }
 };
 
-class Cos : public Function<double, Cos> {
+class Cos : public RealFunction<Cos> {
    public:
-    static double forward(double x) { return std::cos(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::cos(x); }
 
-    static double backward(double x) { return -std::sin(x); }
+    template <std::floating_point T>
+    static T backward(T x) { return -std::sin(x); }
 };
 
-class Tan : public Function<double, Tan> {
+class Tan : public RealFunction<Tan> {
    public:
-    static double forward(double x) { return std::tan(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::tan(x); }
 
-    static double backward(double x) {
-        const double cos = std::cos(x);
-        return 1.0 / (cos * cos);
+    template <std::floating_point T>
+    static T backward(T x) {
+        const T cos = std::cos(x);
+        return T(1) / (cos * cos);
     }
 };
 
-class Ctg : public Function<double, Ctg> {
+class Ctg : public RealFunction<Ctg> {
    public:
-    static double forward(double x) { return 1.0 / std::tan(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return T(1) / std::tan(x); }
 
-    static double backward(double x) {
-        const double sin = std::sin(x);
-        return -1.0 / (sin * sin);
+    template <std::floating_point T>
+    static T backward(T x) {
+        const T sin = std::sin(x);
+        return T(-1) / (sin * sin);
     }
 };
 
-class ArcTan : public Function<double, ArcTan> {
+class ArcTan : public RealFunction<ArcTan> {
    public:
-    static double forward(double x) { return std::atan(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::atan(x); }
 
-    static double backward(double x) { return 1.0 / (x * x + 1.0); }
+    template <std::floating_point T>
+    static T backward(T x) { return T(1) / (x * x + T(1)); }
 };
 
-class ArcSin : public Function<double, ArcSin> {
+class ArcSin : public RealFunction<ArcSin> {
    public:
-    static double forward(double x) { return std::asin(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::asin(x); }
 
-    static double backward(double x) { return 1.0 / std::sqrt(1 - x * x); }
+    template <std::floating_point T>
+    static T backward(T x) { return T(1) / std::sqrt(T(1) - x * x); }
 };
 
-class ArcCos : public Function<double, ArcCos> {
+class ArcCos : public RealFunction<ArcCos> {
    public:
-    static double forward(double x) { return std::acos(x); }
+    template <std::floating_point T>
+    static T forward(T x) { return std::acos(x); }
 
-    static double backward(double x) { return -1.0 / std::sqrt(1 - x * x); }
+    template <std::floating_point T>
+    static T backward(T x) { return T(-1) / std::sqrt(T(1) - x * x); }
 };
 }  // namespace autograd
 
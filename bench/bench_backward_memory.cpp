@@ -0,0 +1,69 @@
+#include <malloc.h>
+#include <sys/resource.h>
+
+#include <iostream>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+constexpr int CHAINS = 100;
+constexpr int DEPTH = 2000;
+constexpr int PROBE_EVERY = 500;
+
+double heap_mb() {
+    return static_cast<double>(mallinfo2().uordblks) / (1024.0 * 1024.0);
+}
+
+double peak_rss_mb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+// Samples the heap in use whenever the backward sweep reaches it.
+class Probe : public Function<double, Probe> {
+   public:
+    static std::vector<double> samples;
+
+    static double forward(double x) { return x; }
+
+    static double backward(double) {
+        samples.push_back(heap_mb());
+        return 1.0;
+    }
+};
+
+std::vector<double> Probe::samples;
+
+int main() {
+    const double baseline = heap_mb();
+    AutoGrad<double> w(0.5, true);
+    std::vector<AutoGrad<double>> chains;
+    for (int c = 0; c < CHAINS; c++) {
+        AutoGrad<double> x(0.01 * c);
+        for (int d = 1; d <= DEPTH; d++) {
+            x = Tanh::call(w * x + AutoGrad<double>(0.1));
+            if (d % PROBE_EVERY == 0)
+                x = Probe::call(x);
+        }
+        chains.push_back(x);
+    }
+    AutoGrad<double> loss = Sum<double>::call(chains);
+    chains.clear();
+    const double forward = heap_mb();
+
+    loss.backward();
+
+    std::cout << "nodes: " << CHAINS * DEPTH * 4 << "\n"
+              << "heap after forward: " << forward - baseline << " MB\n"
+              << "heap during backward:";
+    for (size_t i = 0; i < Probe::samples.size(); i += CHAINS / 4 + 1)
+        std::cout << ' ' << Probe::samples[i] - baseline;
+    std::cout << " MB\n"
+              << "heap after backward: " << heap_mb() - baseline << " MB\n"
+              << "peak rss: " << peak_rss_mb() << " MB\n"
+              << "grad: " << w.grad() << std::endl;
+}
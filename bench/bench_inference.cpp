@@ -0,0 +1,50 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+constexpr int LAYERS = 200;
+constexpr int WIDTH = 50;
+constexpr int REPEATS = 50;
+
+// The same dense chain as the refcount benchmark, forward only.
+template <typename T>
+double run() {
+    std::vector<T> params;
+    for (int i = 0; i < WIDTH; i++)
+        params.emplace_back(0.01 * i);
+    std::vector<T> layer = params;
+    std::vector<T> next;
+    for (int l = 0; l < LAYERS; l++) {
+        next.clear();
+        for (int i = 0; i < WIDTH; i++)
+            next.push_back(Tanh::call(layer[i] * params[i] + layer[(i + 1) % WIDTH]));
+        std::swap(layer, next);
+    }
+    return Sum<double>::call(std::span<const T>(layer)).data();
+}
+
+template <typename T>
+double measure(const char* name) {
+    double checksum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REPEATS; r++)
+        checksum += run<T>();
+    const auto end = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    const double ops = static_cast<double>(REPEATS) * LAYERS * WIDTH * 3;
+    std::cout << name << ": " << ms << " ms, " << ms * 1e6 / ops
+              << " ns per op (checksum " << checksum << ")" << std::endl;
+    return ms;
+}
+
+int main() {
+    auto context = GradContext<double>::no_grad();
+    const double graph = measure<AutoGrad<double>>("no_grad");
+    const double value = measure<Value<double>>("Value");
+    std::cout << "speedup: " << graph / value << "x" << std::endl;
+}
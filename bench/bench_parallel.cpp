@@ -0,0 +1,61 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/parallel.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+constexpr int WIDTH = 32;
+constexpr int BATCH = 512;
+constexpr int REPEATS = 5;
+
+typedef std::vector<double> Sample;
+
+// A one hidden layer network with WIDTH inputs and WIDTH hidden units.
+AutoGrad<double> loss(std::span<const AutoGrad<double>> params, const Sample& x) {
+    std::vector<AutoGrad<double>> hidden;
+    std::vector<AutoGrad<double>> inputs;
+    for (double value : x)
+        inputs.emplace_back(value);
+    for (int h = 0; h < WIDTH; h++) {
+        std::span<const AutoGrad<double>> weights = params.subspan(h * WIDTH, WIDTH);
+        hidden.push_back(Tanh::call(Dot<double>::call(inputs, weights)));
+    }
+    AutoGrad<double> y = Sum<double>::call(hidden);
+    return y * y;
+}
+
+// Usage: bench_parallel [max threads], defaults to the number of cores.
+int main(int argc, char** argv) {
+    std::vector<AutoGrad<double>> params;
+    for (int i = 0; i < WIDTH * WIDTH; i++)
+        params.emplace_back(0.001 * (i % 17), true);
+    std::vector<Sample> batch(BATCH, Sample(WIDTH));
+    for (int i = 0; i < BATCH; i++) {
+        for (int j = 0; j < WIDTH; j++)
+            batch[i][j] = 0.01 * ((i + j) % 13);
+    }
+
+    const size_t max_threads = argc > 1
+                                 ? std::stoul(argv[1])
+                                 : std::max(1u, std::thread::hardware_concurrency());
+    double single = 0.0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        DataParallel<double, Sample> trainer(threads, loss);
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; r++)
+            trainer.backward(params, batch);
+        const auto end = std::chrono::steady_clock::now();
+        const double ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+        if (threads == 1)
+            single = ms;
+        std::cout << threads << " threads: " << ms / REPEATS << " ms per batch, "
+                  << single / ms << "x" << std::endl;
+    }
+}
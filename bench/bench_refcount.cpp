@@ -0,0 +1,48 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+#ifdef AUTOGRAD_INTRUSIVE_REFCOUNT
+constexpr auto POLICY = "intrusive";
+#else
+constexpr auto POLICY = "shared_ptr";
+#endif
+
+constexpr int LAYERS = 200;
+constexpr int WIDTH = 50;
+constexpr int REPEATS = 20;
+
+// A dense chain of layers: many handle copies and edges per node.
+double run() {
+    std::vector<AutoGrad<double>> params;
+    for (int i = 0; i < WIDTH; i++)
+        params.emplace_back(0.01 * i, true);
+    std::vector<AutoGrad<double>> layer = params;
+    for (int l = 0; l < LAYERS; l++) {
+        std::vector<AutoGrad<double>> next;
+        next.reserve(WIDTH);
+        for (int i = 0; i < WIDTH; i++)
+            next.push_back(Tanh::call(layer[i] * params[i] + layer[(i + 1) % WIDTH]));
+        layer = next;
+    }
+    AutoGrad<double> loss = Sum<double>::call(layer);
+    loss.backward();
+    return params[0].grad();
+}
+
+int main() {
+    double checksum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REPEATS; r++)
+        checksum += run();
+    const auto end = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    const double nodes = static_cast<double>(REPEATS) * LAYERS * WIDTH * 3;
+    std::cout << POLICY << ": " << ms << " ms, " << ms * 1e6 / nodes
+              << " ns per node (checksum " << checksum << ")" << std::endl;
+}
@@ -0,0 +1,42 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/scan.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+// Much longer unrolled chains overflow the stack in the recursive topological
+// sort, which scanning avoids altogether.
+constexpr size_t STEPS = 20000;
+
+auto step = [](const auto& x, auto params) {
+    return Tanh::call(params[0] * x + params[1]);
+};
+
+template <typename Run>
+void measure(const char* name, Run run) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.9, true), AutoGrad(0.1, true)};
+    const auto start = std::chrono::steady_clock::now();
+    AutoGrad<double> y = run(params);
+    y.backward();
+    const auto end = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << name << ": " << ms << " ms (grad " << params[0].grad() << ")"
+              << std::endl;
+}
+
+// A recurrence of STEPS steps, unrolled into 3 nodes per step or scanned.
+int main() {
+    measure("unrolled", [](std::span<const AutoGrad<double>> params) {
+        AutoGrad<double> x(0.5);
+        for (size_t t = 0; t < STEPS; t++)
+            x = step(x, params);
+        return x;
+    });
+    measure("scan", [](std::span<const AutoGrad<double>> params) {
+        return Scan<double>::call(step, AutoGrad(0.5), params, STEPS);
+    });
+}
@@ -0,0 +1,29 @@
+#include <fstream>
+#include <iostream>
+
+#include "autograd/core/codegen.h"
+#include "kernel_expression.h"
+
+using namespace autograd;
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " OUTPUT_HEADER" << std::endl;
+        return 1;
+    }
+    LazyGraph<double> graph;
+    std::vector<Lazy<double>> x;
+    for (int i = 0; i < 4; i++)
+        x.push_back(graph.input(AutoGrad(0.0, true)));
+    std::vector<Lazy<double>> outputs =
+        kernel_expression(x, graph.constant(2.0), graph.constant(0.0));
+
+    std::vector<std::string> includes = {
+        "autograd/real/activations.h",
+        "autograd/real/functions.h",
+        "autograd/real/trigonometric.h"
+    };
+    std::ofstream(argv[1]) << CodeGenerator<double>::generate(
+        graph, outputs, "test_kernel", includes
+    );
+}
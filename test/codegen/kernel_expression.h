@@ -0,0 +1,27 @@
+#ifndef KERNEL_EXPRESSION_H
+#define KERNEL_EXPRESSION_H
+
+#include <array>
+#include <vector>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+#include "autograd/real/functions.h"
+#include "autograd/real/trigonometric.h"
+
+// Written once for both AutoGrad<double> and Lazy<double>, so the generated
+// kernel can be checked against the eager graph.
+template <typename T>
+std::vector<T> kernel_expression(const std::vector<T>& x, const T& two, const T& zero) {
+    using namespace autograd;
+    T shared = x[0] * x[1];
+    T a = Sin::call(shared) + Pow<double>::call(x[2], 3) / two
+        + Log<2.0>::call(two + x[3] * x[3]);
+    T b = Ln::call(Exp::call(shared + zero)) * Sum<double>::call(x);
+    T c = Distance::call(std::array{x[0], x[1], x[2], two})
+        + LeakyReLU::call(x[3], 0.1);
+    T d = Dot<double>::call(x, x) - Sigmoid::call(x[0] * x[1]);
+    return {a + b, c * d};
+}
+
+#endif  // KERNEL_EXPRESSION_H
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/codegen.h"
+#include "codegen/kernel_expression.h"
+#include "test_kernel.h"
+
+using namespace autograd;
+
+constexpr double epsilon = 1e-12;
+
+namespace {
+class Twice : public Function<double, Twice> {
+   public:
+    static double forward(double x) { return 2.0 * x; }
+
+    static double backward(double) { return 2.0; }
+};
+}  // namespace
+
+TEST(CodegenTest, GeneratedKernelMatchesGraph) {
+    const std::array<double, 4> inputs = {0.3, -1.2, 2.5, -0.7};
+    const std::array<double, 2> output_grads = {0.7, -1.3};
+    std::vector<AutoGrad<double>> x;
+    for (double input : inputs)
+        x.emplace_back(input, true);
+    std::vector<AutoGrad<double>> outputs =
+        kernel_expression(x, AutoGrad(2.0), AutoGrad(0.0));
+    AutoGrad loss = outputs[0] * AutoGrad(output_grads[0])
+                  + outputs[1] * AutoGrad(output_grads[1]);
+    loss.backward();
+
+    std::array<double, 2> kernel_outputs;
+    std::array<double, 4> kernel_grads;
+    test_kernel(
+        inputs.data(), kernel_outputs.data(), output_grads.data(), kernel_grads.data()
+    );
+
+    EXPECT_NEAR(outputs[0].data(), kernel_outputs[0], epsilon);
+    EXPECT_NEAR(outputs[1].data(), kernel_outputs[1], epsilon);
+    for (size_t i = 0; i < inputs.size(); i++)
+        EXPECT_NEAR(x[i].grad(), kernel_grads[i], epsilon);
+}
+
+TEST(CodegenTest, GeneratedSourceIsOptimized) {
+    LazyGraph<double> graph;
+    Lazy x = graph.input(AutoGrad(1.0, true));
+    Lazy y = graph.input(AutoGrad(2.0, true));
+    Lazy z = Ln::call(Exp::call(x * y)) + Sin::call(x * y) * graph.constant(1.0);
+
+    std::string source =
+        CodeGenerator<double>::generate(graph, std::span(&z, 1), "kernel", {});
+
+    const std::string mul = "autograd::Mul<double>::forward(v0, v1)";
+    EXPECT_NE(std::string::npos, source.find("inline void kernel("));
+    EXPECT_NE(std::string::npos, source.find("autograd::Sin::forward("));
+    EXPECT_NE(std::string::npos, source.find("input_grads[1] += g1;"));
+    EXPECT_EQ(source.find(mul), source.rfind(mul));
+    EXPECT_EQ(std::string::npos, source.find("autograd::Ln"));
+    EXPECT_EQ(std::string::npos, source.find("autograd::Exp"));
+}
+
+TEST(CodegenTest, NonFiniteConstants) {
+    LazyGraph<double> graph;
+    Lazy x = graph.input(AutoGrad(1.0, true));
+    Lazy zero = graph.constant(0.0);
+    Lazy inf = graph.constant(1.0) / zero;
+    Lazy nan = zero / zero;
+    std::array outputs = {x * inf, x * -inf, x + nan};
+
+    std::string source =
+        CodeGenerator<double>::generate(graph, std::span(outputs), "kernel", {});
+
+    EXPECT_NE(std::string::npos, source.find("#include <limits>"));
+    const std::string limits = "std::numeric_limits<double>::";
+    EXPECT_NE(std::string::npos, source.find("= " + limits + "infinity();"));
+    EXPECT_NE(std::string::npos, source.find("= -" + limits + "infinity();"));
+    EXPECT_NE(std::string::npos, source.find("= " + limits + "quiet_NaN();"));
+    EXPECT_EQ(std::string::npos, source.find("inf;"));
+    EXPECT_EQ(std::string::npos, source.find("nan;"));
+}
+
+TEST(CodegenTest, OpsAreSpelledAsSource) {
+    LazyGraph<double> graph;
+    Lazy x = graph.input(AutoGrad(1.0, true));
+    Lazy z = Log<2.0>::call(x) * graph.constant(-0.0);
+
+    std::string source =
+        CodeGenerator<double>::generate(graph, std::span(&z, 1), "kernel", {});
+
+    EXPECT_NE(std::string::npos, source.find("autograd::Log<0x1p+1>::forward(v0)"));
+    EXPECT_NE(std::string::npos, source.find("= -0x0p+0;"));
+}
+
+TEST(CodegenTest, UnnamedOpsThrow) {
+    LazyGraph<double> graph;
+    Lazy x = graph.input(AutoGrad(1.0, true));
+    Lazy z = Twice::call(x);
+
+    EXPECT_THROW(
+        CodeGenerator<double>::generate(graph, std::span(&z, 1), "kernel", {}),
+        std::runtime_error
+    );
+}
+
+TEST(CodegenTest, UnusedInputsGetZeroGradient) {
+    LazyGraph<double> graph;
+    Lazy x = graph.input(AutoGrad(1.0, true));
+    graph.input(AutoGrad(2.0, true));
+    Lazy z = Exp::call(x);
+
+    std::string source =
+        CodeGenerator<double>::generate(graph, std::span(&z, 1), "kernel", {});
+
+    EXPECT_NE(std::string::npos, source.find("input_grads[1] = double{};"));
+    EXPECT_EQ(std::string::npos, source.find("inputs[1]"));
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <filesystem>
+
+#include "autograd/core/autograd.h"
+#include "autograd/io/dataset.h"
+
+using namespace autograd;
+
+class DatasetTest : public testing::Test {
+   protected:
+    // Unique per test and process, as ctest runs tests concurrently.
+    static std::string temp_path() {
+        const std::string test =
+            testing::UnitTest::GetInstance()->current_test_info()->name();
+        const std::string name =
+            "autograd_dataset_" + test + "_" + std::to_string(getpid()) + ".bin";
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::string path = temp_path();
+    std::vector<std::vector<double>> columns = {{}, {}};
+
+    void SetUp() override {
+        for (int i = 0; i < 10; i++) {
+            columns[0].push_back(i);
+            columns[1].push_back(0.5 * i);
+        }
+        write_columnar<double>(path, columns);
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+};
+
+TEST_F(DatasetTest, ColumnsAreMapped) {
+    ColumnarDataset<double> dataset(path);
+
+    EXPECT_EQ(10u, dataset.rows());
+    EXPECT_EQ(2u, dataset.cols());
+    EXPECT_DOUBLE_EQ(7.0, dataset.column(0)[7]);
+    EXPECT_DOUBLE_EQ(3.5, dataset.column(1)[7]);
+}
+
+TEST_F(DatasetTest, BatchesReuseLeaves) {
+    ColumnarDataset<double> dataset(path);
+    BatchStream<double> stream(dataset, 4);
+    std::vector<size_t> sizes;
+    double total = 0.0;
+
+    ASSERT_TRUE(stream.next());
+    Node<double>* first_leaf = stream.column(0)[0].get_node();
+    do {
+        sizes.push_back(stream.size());
+        AutoGrad<double> loss = Dot<double>::call(stream.column(0), stream.column(1));
+        total += loss.data();
+        EXPECT_EQ(first_leaf, stream.column(0)[0].get_node());
+        EXPECT_DOUBLE_EQ(stream.values(1)[0], stream.column(1)[0].data());
+    } while (stream.next());
+
+    EXPECT_EQ(std::vector<size_t>({4, 4, 2}), sizes);
+    EXPECT_DOUBLE_EQ(0.5 * 285.0, total);
+}
+
+TEST_F(DatasetTest, RewindStartsOver) {
+    ColumnarDataset<double> dataset(path);
+    BatchStream<double> stream(dataset, 6);
+
+    while (stream.next()) {
+    }
+    stream.rewind();
+
+    ASSERT_TRUE(stream.next());
+    EXPECT_EQ(0u, stream.first_row());
+    EXPECT_DOUBLE_EQ(5.0, stream.column(0)[5].data());
+}
+
+TEST_F(DatasetTest, OverwritingKeepsMappedDatasetsValid) {
+    ColumnarDataset<double> old(path);
+    std::vector<std::vector<double>> shorter = {{1.0}};
+
+    write_columnar<double>(path, shorter);
+
+    EXPECT_DOUBLE_EQ(4.5, old.column(1)[9]);
+    EXPECT_EQ(1u, ColumnarDataset<double>(path).rows());
+}
+
+TEST_F(DatasetTest, ZeroBatchSizeThrows) {
+    ColumnarDataset<double> dataset(path);
+
+    EXPECT_THROW(BatchStream<double> stream(dataset, 0), std::runtime_error);
+}
+
+TEST_F(DatasetTest, WrongValueTypeThrows) {
+    EXPECT_THROW(ColumnarDataset<float> dataset(path), std::runtime_error);
+    EXPECT_THROW(
+        ColumnarDataset<double> dataset(path + ".missing"), std::runtime_error
+    );
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+#include "autograd/real/functions.h"
+
+using namespace autograd;
+
+TEST(DualTest, TangentsMatchGraphGradients) {
+    Dual<double> x = Dual<double>::variable(0.5, 0, 2);
+    Dual<double> y = Dual<double>::variable(-1.5, 1, 2);
+    AutoGrad<double> gx(0.5, true);
+    AutoGrad<double> gy(-1.5, true);
+
+    Dual<double> r = Exp::call(x * y) + Pow<double>::call(x - y, 3) / -y
+                   + LeakyReLU::call(Tanh::call(x), 0.1);
+    AutoGrad<double> g = Exp::call(gx * gy) + Pow<double>::call(gx - gy, 3) / -gy
+                       + LeakyReLU::call(Tanh::call(gx), 0.1);
+    g.backward();
+
+    EXPECT_DOUBLE_EQ(g.data(), r.data());
+    EXPECT_DOUBLE_EQ(gx.grad(), r.tangent(0));
+    EXPECT_DOUBLE_EQ(gy.grad(), r.tangent(1));
+}
+
+TEST(DualTest, MultiAndVariadic) {
+    std::array<Dual<double>, 4> points = {
+        Dual<double>::variable(0.0, 0, 1), Dual(0.0), Dual(3.0), Dual(4.0)
+    };
+    std::vector<Dual<double>> xs = {
+        Dual<double>::variable(1.0, 0, 1), Dual(2.0), Dual(3.0)
+    };
+    std::vector<Dual<double>> ys = {Dual(4.0), Dual(5.0), Dual(6.0)};
+
+    EXPECT_DOUBLE_EQ(-0.6, Distance::call(points).tangent(0));
+    EXPECT_DOUBLE_EQ(1.0 / 3.0, Mean<double>::call(xs).tangent(0));
+    EXPECT_DOUBLE_EQ(6.0, Prod<double>::call(xs).tangent(0));
+    EXPECT_DOUBLE_EQ(4.0, Dot<double>::call(xs, ys).tangent(0));
+}
+
+TEST(DualTest, ConstantsHaveNoTangents) {
+    Dual<double> c = Exp::call(Dual(1.0)) * Dual(2.0);
+
+    EXPECT_TRUE(c.is_constant());
+    EXPECT_DOUBLE_EQ(0.0, c.tangent(3));
+}
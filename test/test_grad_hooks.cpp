@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/trigonometric.h"
+
+using namespace autograd;
+
+constexpr double epsilon = 1e-9;
+
+std::vector<std::string> events;
+
+class Marker : public Function<double, Marker> {
+   public:
+    static double forward(double x) { return x; }
+
+    static double backward(double) {
+        events.emplace_back("marker");
+        return 1.0;
+    }
+};
+
+TEST(GradHooksTest, HookFiresBeforeBackwardFinishes) {
+    events.clear();
+    AutoGrad x(2.0, true);
+    AutoGrad y(0.5, true);
+    x.register_grad_hook([](const double&) { events.emplace_back("x"); });
+    y.register_grad_hook([](const double&) { events.emplace_back("y"); });
+
+    AutoGrad z = x * Marker::call(Sin::call(Sin::call(y)));
+    z.backward();
+
+    ASSERT_EQ(std::vector<std::string>({"x", "marker", "y"}), events);
+}
+
+TEST(GradHooksTest, HookSeesAllContributions) {
+    AutoGrad x(2.0, true);
+    std::vector<double> seen;
+    x.register_grad_hook([&](const double& grad) { seen.push_back(grad); });
+
+    AutoGrad z = x * x + Sin::call(Cos::call(x)) + x;
+    z.backward();
+
+    ASSERT_EQ(1u, seen.size());
+    EXPECT_NEAR(x.grad(), seen[0], epsilon);
+    EXPECT_NEAR(4.0 - std::cos(std::cos(2.0)) * std::sin(2.0) + 1.0, seen[0], epsilon);
+}
+
+TEST(GradHooksTest, HooksOnRootLeaf) {
+    AutoGrad x(2.0, true);
+    int calls = 0;
+    x.register_grad_hook([&](const double&) { calls++; });
+    x.register_grad_hook([&](const double&) { calls++; });
+
+    x.backward();
+
+    EXPECT_EQ(2, calls);
+}
+
+TEST(GradHooksTest, HookOnNonLeafThrows) {
+    AutoGrad x(2.0, true);
+    AutoGrad y = Sin::call(x);
+
+    EXPECT_THROW(y.register_grad_hook([](const double&) {}), std::runtime_error);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <concepts>
+#include <span>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/implicit.h"
+#include "autograd/real/functions.h"
+
+using namespace autograd;
+
+// Babylonian iteration, converges to sqrt(params[0]).
+auto babylonian = [](const auto& x, auto params) {
+    typedef std::decay_t<decltype(x)> T;
+    return T(0.5) * (x + params[0] / x);
+};
+
+// Root at the cube root of params[0] * params[1].
+auto cubic = [](const auto& x, auto params) {
+    return Pow<double>::call(x, 3) - params[0] * params[1];
+};
+
+TEST(ImplicitTest, FixedPoint) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(2.0, true)};
+
+    AutoGrad<double> x = FixedPoint<double>::call(babylonian, 1.0, params, 1e-14);
+    EXPECT_EQ(1u, x.get_node()->edges().size());
+    x.backward();
+
+    EXPECT_DOUBLE_EQ(std::sqrt(2.0), x.data());
+    EXPECT_NEAR(0.5 / std::sqrt(2.0), params[0].grad(), 1e-12);
+}
+
+TEST(ImplicitTest, RootSolve) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(2.0, true), AutoGrad(4.0)};
+
+    AutoGrad<double> x = RootSolve<double>::call(cubic, 1.0, params, 1e-12);
+    AutoGrad<double> y = Exp::call(x);
+    y.backward();
+
+    EXPECT_NEAR(2.0, x.data(), 1e-12);
+    // x = (ab)^(1/3), dx/da = b / (3 x^2).
+    EXPECT_NEAR(std::exp(2.0) * 4.0 / 12.0, params[0].grad(), 1e-9);
+    EXPECT_FALSE(params[1].has_grad());
+}
+
+TEST(ImplicitTest, ComposesInGraph) {
+    AutoGrad<double> a(9.0, true);
+    std::vector<AutoGrad<double>> params = {a * a};
+
+    AutoGrad<double> x = FixedPoint<double>::call(babylonian, 1.0, params, 1e-14);
+    x.backward();
+
+    EXPECT_DOUBLE_EQ(9.0, x.data());
+    EXPECT_NEAR(1.0, a.grad(), 1e-12);
+}
+
+TEST(ImplicitTest, RootSolveInsideNoGrad) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(8.0, true), AutoGrad(1.0)};
+    auto context = GradContext<double>::no_grad();
+
+    AutoGrad<double> x = RootSolve<double>::call(cubic, 1.0, params, 1e-12);
+
+    EXPECT_NEAR(2.0, x.data(), 1e-12);
+    EXPECT_TRUE(x.get_node()->edges().empty());
+    EXPECT_FALSE(GradContext<double>::grad_enabled());
+}
+
+TEST(ImplicitTest, BackwardInsideNoGrad) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(2.0, true)};
+    AutoGrad<double> x = FixedPoint<double>::call(babylonian, 1.0, params, 1e-14);
+    auto context = GradContext<double>::no_grad();
+
+    x.backward();
+
+    EXPECT_NEAR(0.5 / std::sqrt(2.0), params[0].grad(), 1e-12);
+    EXPECT_FALSE(GradContext<double>::grad_enabled());
+}
+
+TEST(ImplicitTest, SolversNeverBuildGraphs) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(8.0, true), AutoGrad(1.0)};
+    auto plain_cubic = []<typename T>(const T& x, std::span<const T> params)
+        requires(!std::same_as<T, AutoGrad<double>>)
+    { return cubic(x, params); };
+
+    AutoGrad<double> x = RootSolve<double>::call(plain_cubic, 1.0, params, 1e-12);
+    x.backward();
+
+    EXPECT_NEAR(2.0, x.data(), 1e-12);
+    EXPECT_NEAR(1.0 / 12.0, params[0].grad(), 1e-9);
+}
+
+TEST(ImplicitTest, NoConvergenceThrows) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(1.0, true)};
+    auto shift = [](const auto& x, auto params) { return x + params[0]; };
+
+    EXPECT_THROW(FixedPoint<double>::call(shift, 0.0, params, 0.5), std::runtime_error);
+    EXPECT_THROW(RootSolve<double>::call(shift, 0.0, params, -1.0), std::runtime_error);
+}
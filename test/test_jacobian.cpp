@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/jacobian.h"
+#include "autograd/real/trigonometric.h"
+
+using namespace autograd;
+
+constexpr double epsilon = 1e-9;
+
+TEST(JacobianTest, BandedJacobianNeedsFewColors) {
+    constexpr size_t n = 100;
+    std::vector<AutoGrad<double>> xs;
+    for (size_t i = 0; i < n; i++)
+        xs.emplace_back(0.1 * static_cast<double>(i), true);
+    std::vector<AutoGrad<double>> ys;
+    for (size_t i = 0; i + 1 < n; i++)
+        ys.push_back(Sin::call(xs[i]) * xs[i + 1]);
+
+    SparseJacobian<double> jacobian(ys, xs);
+    CsrMatrix<double> matrix = jacobian.compute();
+
+    EXPECT_EQ(2u, jacobian.colors());
+    EXPECT_EQ(n - 1, matrix.rows);
+    EXPECT_EQ(n, matrix.cols);
+    EXPECT_EQ(2 * (n - 1), matrix.non_zeros());
+    for (size_t i = 0; i + 1 < n; i++) {
+        const double x = xs[i].data();
+        const double next = xs[i + 1].data();
+        EXPECT_NEAR(std::cos(x) * next, *matrix.at(i, i), epsilon);
+        EXPECT_NEAR(std::sin(x), *matrix.at(i, i + 1), epsilon);
+        EXPECT_FALSE(matrix.at(i, (i + 2) % n).has_value());
+    }
+}
+
+TEST(JacobianTest, SharedIntermediateNodes) {
+    AutoGrad x(1.0, true);
+    AutoGrad y(2.0, true);
+    AutoGrad z(3.0, true);
+    AutoGrad shared = x * y;
+    std::vector<AutoGrad<double>> outputs = {shared + z, Sin::call(shared), z * z};
+    std::vector<AutoGrad<double>> inputs = {x, y, z};
+
+    SparseJacobian<double> jacobian(outputs, inputs);
+    CsrMatrix<double> matrix = jacobian.compute();
+
+    EXPECT_EQ(2u, jacobian.colors());
+    EXPECT_DOUBLE_EQ(2.0, *matrix.at(0, 0));
+    EXPECT_DOUBLE_EQ(1.0, *matrix.at(0, 1));
+    EXPECT_DOUBLE_EQ(1.0, *matrix.at(0, 2));
+    EXPECT_NEAR(2.0 * std::cos(2.0), *matrix.at(1, 0), epsilon);
+    EXPECT_NEAR(std::cos(2.0), *matrix.at(1, 1), epsilon);
+    EXPECT_FALSE(matrix.at(1, 2).has_value());
+    EXPECT_FALSE(matrix.at(2, 0).has_value());
+    EXPECT_DOUBLE_EQ(6.0, *matrix.at(2, 2));
+}
+
+TEST(JacobianTest, LeafGradientsAndGraphArePreserved) {
+    AutoGrad x(2.0, true);
+    AutoGrad y(3.0, true);
+    (x * y).backward();
+    AutoGrad z = x * x;
+    std::vector<AutoGrad<double>> outputs = {z, y * y};
+    std::vector<AutoGrad<double>> inputs = {x, y};
+
+    CsrMatrix<double> matrix = SparseJacobian<double>(outputs, inputs).compute();
+    z.backward();
+
+    EXPECT_DOUBLE_EQ(4.0, *matrix.at(0, 0));
+    EXPECT_DOUBLE_EQ(6.0, *matrix.at(1, 1));
+    EXPECT_DOUBLE_EQ(3.0 + 4.0, x.grad());
+    EXPECT_DOUBLE_EQ(2.0, y.grad());
+}
+
+TEST(JacobianTest, OutlivesCallerHandles) {
+    std::optional<SparseJacobian<double>> jacobian;
+    {
+        AutoGrad x(2.0, true);
+        AutoGrad y(3.0, true);
+        std::vector<AutoGrad<double>> outputs = {x * y, Sin::call(y)};
+        std::vector<AutoGrad<double>> inputs = {x, y};
+        jacobian.emplace(outputs, inputs);
+    }
+
+    CsrMatrix<double> matrix = jacobian->compute();
+
+    EXPECT_DOUBLE_EQ(3.0, *matrix.at(0, 0));
+    EXPECT_DOUBLE_EQ(2.0, *matrix.at(0, 1));
+    EXPECT_NEAR(std::cos(3.0), *matrix.at(1, 1), epsilon);
+}
+
+TEST(JacobianTest, NonLeafInputThrows) {
+    AutoGrad x(2.0, true);
+    AutoGrad y = x * x;
+    std::vector<AutoGrad<double>> outputs = {y};
+    std::vector<AutoGrad<double>> inputs = {y};
+
+    EXPECT_THROW(SparseJacobian<double>(outputs, inputs), std::runtime_error);
+}
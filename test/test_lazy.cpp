@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/lazy.h"
+#include "autograd/real/functions.h"
+#include "autograd/real/trigonometric.h"
+
+using namespace autograd;
+
+constexpr double epsilon = 1e-9;
+
+TEST(LazyTest, MatchesEagerEvaluation) {
+    AutoGrad x(2.0, true);
+    AutoGrad y(3.0, true);
+    LazyGraph<double> graph;
+    Lazy lx = graph.input(x);
+    Lazy ly = graph.input(y);
+
+    Lazy lz = Sin::call(lx * ly) + Pow<double>::call(lx, 3) / ly;
+    AutoGrad z = graph.evaluate(lz);
+    z.backward();
+
+    EXPECT_NEAR(std::sin(6.0) + 8.0 / 3.0, z.data(), epsilon);
+    EXPECT_NEAR(3.0 * std::cos(6.0) + 4.0, x.grad(), epsilon);
+    EXPECT_NEAR(2.0 * std::cos(6.0) - 8.0 / 9.0, y.grad(), epsilon);
+}
+
+TEST(LazyTest, CommonSubExpressionsAreMerged) {
+    AutoGrad x(1.0, true);
+    LazyGraph<double> graph;
+    Lazy lx = graph.input(x);
+
+    Lazy lz = Exp::call(lx * lx) + Exp::call(lx * lx);
+    AutoGrad z = graph.evaluate(lz);
+    z.backward();
+
+    EXPECT_EQ(2u, graph.stats().merged);
+    EXPECT_EQ(3u, graph.stats().executed);
+    EXPECT_NEAR(2.0 * std::exp(1.0), z.data(), epsilon);
+    EXPECT_NEAR(4.0 * std::exp(1.0), x.grad(), epsilon);
+}
+
+TEST(LazyTest, ConstantsAreFolded) {
+    AutoGrad x(2.0, true);
+    LazyGraph<double> graph;
+    Lazy lx = graph.input(x);
+
+    Lazy lz = lx * Exp::call(graph.constant(0.0) + graph.constant(1.0));
+    AutoGrad z = graph.evaluate(lz);
+    z.backward();
+
+    EXPECT_EQ(2u, graph.stats().folded);
+    EXPECT_EQ(1u, graph.stats().executed);
+    EXPECT_NEAR(2.0 * std::exp(1.0), z.data(), epsilon);
+    EXPECT_NEAR(std::exp(1.0), x.grad(), epsilon);
+}
+
+TEST(LazyTest, AlgebraicSimplification) {
+    AutoGrad x(2.0, true);
+    LazyGraph<double> graph;
+    Lazy lx = graph.input(x);
+    Lazy one = graph.constant(1.0);
+    Lazy zero = graph.constant(0.0);
+
+    Lazy lz = Ln::call(Exp::call(-(-(lx * one + zero))));
+    AutoGrad z = Sin::call(graph.evaluate(lz));
+    z.backward();
+
+    EXPECT_EQ(4u, graph.stats().simplified);
+    EXPECT_EQ(0u, graph.stats().executed);
+    EXPECT_NEAR(std::sin(2.0), z.data(), epsilon);
+    EXPECT_NEAR(std::cos(2.0), x.grad(), epsilon);
+}
+
+TEST(LazyTest, DeadNodesAreNotExecuted) {
+    AutoGrad x(2.0, true);
+    LazyGraph<double> graph;
+    Lazy lx = graph.input(x);
+
+    Exp::call(lx) * lx;
+    Lazy lz = Cos::call(lx);
+    std::vector<Lazy<double>> outputs = {lz};
+    AutoGrad z = graph.evaluate(outputs)[0];
+
+    EXPECT_EQ(3u, graph.stats().recorded);
+    EXPECT_EQ(2u, graph.stats().removed);
+    EXPECT_EQ(1u, graph.stats().executed);
+    EXPECT_NEAR(std::cos(2.0), z.data(), epsilon);
+}
+
+TEST(LazyTest, VariadicAndMultiArgFunctions) {
+    AutoGrad x(1.0, true);
+    AutoGrad y(2.0, true);
+    LazyGraph<double> graph;
+    std::vector<Lazy<double>> args = {graph.input(x), graph.input(y)};
+
+    Lazy lz = Sum<double>::call(args)
+            * Distance::call(std::array{
+                  args[0], args[1], graph.constant(4.0), graph.constant(6.0)
+              });
+    AutoGrad z = graph.evaluate(lz);
+    z.backward();
+
+    EXPECT_DOUBLE_EQ(15.0, z.data());
+    EXPECT_DOUBLE_EQ(5.0 - 3.0 * 0.6, x.grad());
+    EXPECT_DOUBLE_EQ(5.0 - 3.0 * 0.8, y.grad());
+}
+
+TEST(LazyTest, MixingGraphsThrows) {
+    LazyGraph<double> first;
+    LazyGraph<double> second;
+
+    EXPECT_THROW(first.constant(1.0) + second.constant(1.0), std::runtime_error);
+}
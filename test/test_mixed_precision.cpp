@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+#include "autograd/real/functions.h"
+#include "autograd/real/softmax.h"
+
+using namespace autograd;
+
+TEST(MixedPrecisionTest, FloatValuesHaveDoubleGradients) {
+    AutoGrad x(3.0f, true);
+    AutoGrad y(2.0f, true);
+
+    AutoGrad z = x * y + x / y;
+    z.backward();
+
+    static_assert(std::is_same_v<std::decay_t<decltype(z.data())>, float>);
+    static_assert(std::is_same_v<std::decay_t<decltype(x.grad())>, double>);
+    EXPECT_FLOAT_EQ(7.5f, z.data());
+    EXPECT_DOUBLE_EQ(2.5, x.grad());
+    EXPECT_DOUBLE_EQ(2.25, y.grad());
+}
+
+TEST(MixedPrecisionTest, ManyContributionsAccumulateInDouble) {
+    constexpr int steps = 100000;
+    AutoGrad x(1.0f, true);
+    AutoGrad c(0.1f);
+    float float_sum = 0.0f;
+
+    for (int i = 0; i < steps; i++) {
+        (x * c).backward();
+        float_sum += 0.1f;
+    }
+
+    const double expected = static_cast<double>(0.1f) * steps;
+    EXPECT_NEAR(expected, x.grad(), 1e-6);
+    EXPECT_GT(std::abs(expected - float_sum), 1e-1);
+}
+
+TEST(MixedPrecisionTest, ContextIsSharedPerField) {
+    AutoGrad x(2.0f, true);
+    auto context = GradContext<float>::no_grad();
+
+    EXPECT_FALSE(Pow<float>::call(x, 2).requires_grad());
+}
+
+TEST(MixedPrecisionTest, RealOpsRunOnFloat) {
+    AutoGrad x(0.5f, true);
+    AutoGrad y(-1.5f, true);
+
+    AutoGrad z = Tanh::call(x * y) + Exp::call(y);
+    z.backward();
+
+    const double tanh_grad = 1.0 - std::tanh(-0.75) * std::tanh(-0.75);
+    static_assert(std::is_same_v<decltype(z), AutoGrad<float>>);
+    EXPECT_FLOAT_EQ(std::tanh(-0.75f) + std::exp(-1.5f), z.data());
+    EXPECT_NEAR(tanh_grad * -1.5, x.grad(), 1e-6);
+    EXPECT_NEAR(tanh_grad * 0.5 + std::exp(-1.5), y.grad(), 1e-6);
+}
+
+TEST(MixedPrecisionTest, CrossEntropyRunsOnFloat) {
+    std::vector<AutoGrad<float>> logits = {
+        AutoGrad(1.0f, true), AutoGrad(2.0f, true), AutoGrad(0.5f, true)
+    };
+
+    AutoGrad<float> loss = CrossEntropy::call(logits, 1);
+    loss.backward();
+
+    std::vector<AutoGrad<float>> softmax = Softmax::call(logits);
+    EXPECT_NEAR(-std::log(softmax[1].data()), loss.data(), 1e-6);
+    EXPECT_NEAR(softmax[0].data(), logits[0].grad(), 1e-6);
+    EXPECT_NEAR(softmax[1].data() - 1.0, logits[1].grad(), 1e-6);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/parallel.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+typedef std::pair<double, double> Sample;
+
+AutoGrad<double>
+squared_error(std::span<const AutoGrad<double>> params, const Sample& s) {
+    AutoGrad<double> prediction = Tanh::call(params[0] * AutoGrad(s.first) + params[1]);
+    AutoGrad<double> error = prediction - AutoGrad(s.second);
+    return error * error;
+}
+
+class ParallelTest : public testing::Test {
+   protected:
+    std::vector<Sample> batch;
+
+    void SetUp() override {
+        for (int i = 0; i < 37; i++)
+            batch.emplace_back(0.1 * i, 0.5 - 0.02 * i);
+    }
+};
+
+TEST_F(ParallelTest, MatchesSerialGradient) {
+    std::vector<AutoGrad<double>> expected = {AutoGrad(0.3, true), AutoGrad(-0.2)};
+    std::vector<AutoGrad<double>> losses;
+    for (const Sample& sample : batch)
+        losses.push_back(squared_error(expected, sample));
+    AutoGrad<double> total = Sum<double>::call(losses);
+    total.backward();
+
+    for (size_t threads : {1, 2, 3, 4, 8, 64}) {
+        std::vector<AutoGrad<double>> params = {AutoGrad(0.3, true), AutoGrad(-0.2)};
+        DataParallel<double, Sample> trainer(threads, squared_error);
+
+        const double loss = trainer.backward(params, batch);
+
+        EXPECT_NEAR(total.data(), loss, 1e-12);
+        EXPECT_NEAR(expected[0].grad(), params[0].grad(), 1e-12);
+        EXPECT_FALSE(params[1].has_grad());
+    }
+}
+
+TEST_F(ParallelTest, AccumulatesIntoExistingGrads) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.3, true), AutoGrad(-0.2, true)};
+    DataParallel<double, Sample> trainer(3, squared_error);
+
+    trainer.backward(params, batch);
+    const double once = params[1].grad();
+    trainer.backward(params, batch);
+
+    EXPECT_NEAR(2 * once, params[1].grad(), 1e-12);
+}
+
+TEST_F(ParallelTest, WorkerErrorsAreRethrown) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.3, true), AutoGrad(-0.2, true)};
+    DataParallel<double, Sample> trainer(4, [](auto params, const Sample& sample) {
+        if (sample.first > 3.0)
+            throw std::runtime_error("bad sample");
+        return squared_error(params, sample);
+    });
+
+    EXPECT_THROW(trainer.backward(params, batch), std::runtime_error);
+    EXPECT_THROW((DataParallel<double, Sample>(0, squared_error)), std::runtime_error);
+}
+
+TEST(ParallelContextTest, NoGradIsPerThread) {
+    auto context = GradContext<double>::no_grad();
+    bool enabled = false;
+    std::thread([&] { enabled = GradContext<double>::grad_enabled(); }).join();
+
+    EXPECT_TRUE(enabled);
+    EXPECT_FALSE(GradContext<double>::grad_enabled());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/functions.h"
+
+using namespace autograd;
+
+class Counted {
+   public:
+    static int live;
+    double value;
+
+    Counted(double value = 0.0) : value(value) { live++; }
+
+    Counted(const Counted& other) : value(other.value) { live++; }
+
+    Counted& operator=(const Counted& other) = default;
+
+    ~Counted() { live--; }
+
+    Counted operator+(const Counted& other) const { return value + other.value; }
+
+    Counted operator-(const Counted& other) const { return value - other.value; }
+
+    Counted operator*(const Counted& other) const { return value * other.value; }
+
+    Counted operator/(const Counted& other) const { return value / other.value; }
+
+    Counted operator-() const { return -value; }
+
+    Counted& operator+=(const Counted& other) {
+        value += other.value;
+        return *this;
+    }
+};
+
+int Counted::live = 0;
+
+template <>
+class autograd::FieldTraits<Counted> {
+   public:
+    typedef const Counted& arg_type;
+    inline static const Counted one = 1.0;
+    static Counted reverse(const Counted& x) { return 1.0 / x.value; }
+};
+
+// Records how many values are alive whenever its gradient is computed.
+class Probe : public Function<Counted, Probe> {
+   public:
+    static std::vector<int> samples;
+
+    static Counted forward(const Counted& x) { return x; }
+
+    static Counted backward(const Counted&) {
+        samples.push_back(Counted::live);
+        return 1.0;
+    }
+};
+
+std::vector<int> Probe::samples;
+
+TEST(ReleaseTest, IntermediateNodesAreFreedDuringBackward) {
+    AutoGrad<Counted> x(Counted(1.0), true);
+    AutoGrad<Counted> y = x;
+    for (int i = 0; i < 50; i++)
+        y = Probe::call(y * AutoGrad<Counted>(Counted(1.0)));
+    const int before = Counted::live;
+
+    Probe::samples.clear();
+    y.backward();
+
+    ASSERT_EQ(50u, Probe::samples.size());
+    EXPECT_LT(Probe::samples.back(), before / 2);
+    for (size_t i = 1; i < Probe::samples.size(); i++)
+        EXPECT_LT(Probe::samples[i], Probe::samples[i - 1]);
+    EXPECT_DOUBLE_EQ(1.0, x.grad().value);
+}
+
+TEST(ReleaseTest, HeldNodesKeepTheirData) {
+    AutoGrad x(2.0, true);
+    AutoGrad y = Exp::call(x);
+    AutoGrad z = Ln::call(y);
+
+    z.backward();
+
+    EXPECT_DOUBLE_EQ(std::exp(2.0), y.data());
+    EXPECT_TRUE(y.requires_grad());
+    EXPECT_FALSE(y.has_grad());
+    EXPECT_DOUBLE_EQ(1.0, x.grad());
+}
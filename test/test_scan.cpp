@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/scan.h"
+#include "autograd/real/activations.h"
+
+using namespace autograd;
+
+auto rnn_step = [](const auto& x, auto params) {
+    return Tanh::call(params[0] * x + params[1]);
+};
+
+TEST(ScanTest, MatchesUnrolledRecurrence) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.9, true), AutoGrad(0.1, true)};
+    AutoGrad<double> x0(0.5, true);
+    std::vector<AutoGrad<double>> unrolled_params = {
+        AutoGrad(0.9, true), AutoGrad(0.1, true)
+    };
+    AutoGrad<double> unrolled_x0(0.5, true);
+
+    AutoGrad<double> y = Scan<double>::call(rnn_step, x0, params, 50);
+    AutoGrad<double> expected = unrolled_x0;
+    for (int t = 0; t < 50; t++)
+        expected = rnn_step(expected, std::span(std::as_const(unrolled_params)));
+    y.backward();
+    expected.backward();
+
+    EXPECT_DOUBLE_EQ(expected.data(), y.data());
+    EXPECT_NEAR(unrolled_x0.grad(), x0.grad(), 1e-12);
+    EXPECT_NEAR(unrolled_params[0].grad(), params[0].grad(), 1e-12);
+    EXPECT_NEAR(unrolled_params[1].grad(), params[1].grad(), 1e-12);
+}
+
+TEST(ScanTest, SingleNode) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.9, true), AutoGrad(0.1)};
+    AutoGrad<double> x0(0.5);
+
+    AutoGrad<double> y = Scan<double>::call(rnn_step, x0, params, 100000);
+
+    EXPECT_EQ(3u, y.get_node()->edges().size());
+    for (const auto& edge : y.get_node()->edges())
+        EXPECT_TRUE(edge->is_leaf());
+    y.backward();
+    EXPECT_TRUE(params[0].has_grad());
+    EXPECT_FALSE(params[1].has_grad());
+    EXPECT_FALSE(x0.has_grad());
+}
+
+TEST(ScanTest, ZeroStepsAndUnusedParams) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(3.0, true), AutoGrad(5.0, true)};
+    AutoGrad<double> x0(2.0, true);
+
+    AutoGrad<double> y = Scan<double>::call(rnn_step, x0, params, 0);
+    AutoGrad<double> z = Scan<double>::call(
+        [](const auto& x, auto params) { return x * params[0]; }, x0, params, 3
+    );
+    y.backward();
+    z.backward();
+
+    EXPECT_DOUBLE_EQ(2.0, y.data());
+    EXPECT_DOUBLE_EQ(54.0, z.data());
+    EXPECT_DOUBLE_EQ(1.0 + 27.0, x0.grad());
+    EXPECT_DOUBLE_EQ(3 * 2.0 * 9.0, params[0].grad());
+    EXPECT_DOUBLE_EQ(0.0, params[1].grad());
+}
+
+TEST(ScanTest, BackwardInsideNoGrad) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.9, true), AutoGrad(0.1, true)};
+    std::vector<AutoGrad<double>> unrolled_params = {
+        AutoGrad(0.9, true), AutoGrad(0.1, true)
+    };
+    AutoGrad<double> y = Scan<double>::call(rnn_step, AutoGrad(0.5), params, 20);
+    AutoGrad<double> expected(0.5);
+    for (int t = 0; t < 20; t++)
+        expected = rnn_step(expected, std::span(std::as_const(unrolled_params)));
+    auto context = GradContext<double>::no_grad();
+
+    y.backward();
+    expected.backward();
+
+    EXPECT_NEAR(unrolled_params[0].grad(), params[0].grad(), 1e-12);
+    EXPECT_NEAR(unrolled_params[1].grad(), params[1].grad(), 1e-12);
+    EXPECT_FALSE(GradContext<double>::grad_enabled());
+}
+
+TEST(ScanTest, NoGraphWithoutGrad) {
+    std::vector<AutoGrad<double>> params = {AutoGrad(0.9, true), AutoGrad(0.1)};
+    auto context = GradContext<double>::no_grad();
+
+    AutoGrad<double> y = Scan<double>::call(rnn_step, AutoGrad(0.5), params, 10);
+
+    EXPECT_TRUE(y.get_node()->edges().empty());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+#include "autograd/real/trigonometric.h"
+
+using namespace autograd;
+
+int counted_calls = 0;
+
+class CountedCalls : public Function<double, CountedCalls> {
+   public:
+    static double forward(double x) { return x; }
+
+    static double backward(double) {
+        counted_calls++;
+        return 1.0;
+    }
+};
+
+AutoGrad<double> chain(const AutoGrad<double>& x, int length) {
+    AutoGrad<double> y = x;
+    for (int i = 0; i < length; i++)
+        y = CountedCalls::call(Sin::call(y));
+    return y;
+}
+
+TEST(SkipZerosTest, InactiveBranchIsSkipped) {
+    counted_calls = 0;
+    AutoGrad x(0.5, true);
+    AutoGrad y(3.0, true);
+
+    AutoGrad z = ReLU::call(-chain(x, 10)) + y * y;
+    BackwardStats stats = z.backward_skip_zeros();
+
+    EXPECT_EQ(0, counted_calls);
+    EXPECT_FALSE(x.has_grad());
+    EXPECT_DOUBLE_EQ(6.0, y.grad());
+    // ReLU still runs and passes a zero to FlipSign, which is skipped along with
+    // the 20 nodes of the chain behind it.
+    EXPECT_EQ(21u, stats.skipped);
+    EXPECT_EQ(3u, stats.visited);
+}
+
+TEST(SkipZerosTest, MatchesBackwardOnNonzeroPaths) {
+    AutoGrad x(0.5, true);
+    AutoGrad x_expected(0.5, true);
+
+    AutoGrad z = chain(x, 5) * LeakyReLU::call(x, 0.0) + ReLU::call(-x);
+    AutoGrad expected = chain(x_expected, 5) * LeakyReLU::call(x_expected, 0.0)
+                      + ReLU::call(-x_expected);
+    BackwardStats stats = z.backward_skip_zeros();
+    expected.backward();
+
+    EXPECT_DOUBLE_EQ(expected.data(), z.data());
+    EXPECT_DOUBLE_EQ(x_expected.grad(), x.grad());
+    EXPECT_EQ(1u, stats.skipped);
+}
+
+TEST(SkipZerosTest, HooksStillFire) {
+    AutoGrad x(-1.0, true);
+    AutoGrad y(2.0, true);
+    std::vector<double> seen;
+    x.register_grad_hook([&](const double& grad) { seen.push_back(grad); });
+    y.register_grad_hook([&](const double& grad) { seen.push_back(grad); });
+
+    AutoGrad z = ReLU::call(x) * y + y;
+    z.backward_skip_zeros();
+
+    EXPECT_EQ(std::vector<double>({1.0, 0.0}), seen);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+
+#include "autograd/core/autograd.h"
+#include "autograd/io/snapshot.h"
+
+using namespace autograd;
+
+class SnapshotTest : public testing::Test {
+   protected:
+    // Unique per test and process, as ctest runs tests concurrently.
+    static std::string temp_path() {
+        const std::string test =
+            testing::UnitTest::GetInstance()->current_test_info()->name();
+        const std::string name =
+            "autograd_snapshot_" + test + "_" + std::to_string(getpid()) + ".bin";
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::string path = temp_path();
+    std::vector<AutoGrad<double>> params = {
+        AutoGrad(1.5, true), AutoGrad(-2.0, true), AutoGrad(0.25, true)
+    };
+
+    void TearDown() override { std::filesystem::remove(path); }
+};
+
+TEST_F(SnapshotTest, ValuesRoundTrip) {
+    Snapshot<double>::save(path, params);
+    Snapshot<double> snapshot(path);
+
+    EXPECT_EQ(3u, snapshot.size());
+    EXPECT_FALSE(snapshot.has_grads());
+    EXPECT_EQ(0u, snapshot.state_count());
+
+    std::vector<AutoGrad<double>> loaded = snapshot.load();
+    ASSERT_EQ(3u, loaded.size());
+    for (size_t i = 0; i < params.size(); i++) {
+        EXPECT_EQ(params[i].data(), loaded[i].data());
+        EXPECT_TRUE(loaded[i].requires_grad());
+        EXPECT_FALSE(loaded[i].get_node()->has_grad());
+    }
+}
+
+TEST_F(SnapshotTest, GradsAndStateRoundTrip) {
+    AutoGrad<double> loss = params[0] * params[1];
+    loss.backward();
+    std::vector<std::vector<double>> moments = {{0.1, 0.2, 0.3}, {1.0, 2.0, 3.0}};
+
+    Snapshot<double>::save(path, params, true, moments);
+    Snapshot<double> snapshot(path);
+
+    ASSERT_TRUE(snapshot.has_grads());
+    std::span<const double> grads = snapshot.grads();
+    EXPECT_EQ(
+        std::vector<double>({-2.0, 1.5, 0.0}),
+        std::vector<double>(grads.begin(), grads.end())
+    );
+    ASSERT_EQ(2u, snapshot.state_count());
+    EXPECT_DOUBLE_EQ(0.2, snapshot.state(0)[1]);
+    EXPECT_DOUBLE_EQ(3.0, snapshot.state(1)[2]);
+
+    for (AutoGrad<double>& param : params) {
+        param.data() = 0.0;
+        param.get_node()->clear_grad();
+    }
+    snapshot.restore(params);
+    EXPECT_DOUBLE_EQ(-2.0, params[1].data());
+    EXPECT_DOUBLE_EQ(1.5, params[1].grad());
+}
+
+TEST_F(SnapshotTest, MixedPrecisionArraysAreAligned) {
+    std::vector<AutoGrad<float>> floats = {
+        AutoGrad(1.5f, true), AutoGrad(-2.0f, true), AutoGrad(0.25f, true)
+    };
+    AutoGrad<float> loss = floats[0] * floats[1] + floats[2];
+    loss.backward();
+    std::vector<std::vector<double>> moments = {{0.1, 0.2, 0.3}};
+
+    Snapshot<float>::save(path, floats, true, moments);
+    Snapshot<float> snapshot(path);
+    std::vector<AutoGrad<float>> loaded = snapshot.load();
+
+    auto aligned = [](const double* pointer) {
+        return reinterpret_cast<uintptr_t>(pointer) % alignof(double) == 0;
+    };
+    EXPECT_TRUE(aligned(snapshot.grads().data()));
+    EXPECT_TRUE(aligned(snapshot.state(0).data()));
+    for (size_t i = 0; i < floats.size(); i++) {
+        EXPECT_EQ(floats[i].data(), loaded[i].data());
+        EXPECT_EQ(floats[i].grad(), loaded[i].grad());
+    }
+    EXPECT_DOUBLE_EQ(0.3, snapshot.state(0)[2]);
+}
+
+TEST_F(SnapshotTest, OverwritingKeepsMappedSnapshotsValid) {
+    std::vector<AutoGrad<double>> many;
+    for (int i = 0; i < 100000; i++)
+        many.emplace_back(0.5 * i);
+    Snapshot<double>::save(path, many);
+    Snapshot<double> old(path);
+
+    Snapshot<double>::save(path, params);
+
+    EXPECT_DOUBLE_EQ(45000.0, old.values()[90000]);
+    EXPECT_EQ(3u, Snapshot<double>(path).size());
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+}
+
+TEST_F(SnapshotTest, MismatchesThrow) {
+    Snapshot<double>::save(path, params);
+    Snapshot<double> snapshot(path);
+    std::vector<std::vector<double>> short_state = {{1.0}};
+    std::vector<AutoGrad<double>> not_leaves = {params[0] + params[1], params[1]};
+    not_leaves.push_back(params[2]);
+
+    EXPECT_THROW(snapshot.restore(std::span(params).first(2)), std::runtime_error);
+    EXPECT_THROW(snapshot.restore(not_leaves), std::runtime_error);
+    std::vector<AutoGrad<double>> last_not_leaf = {params[0], params[1], -params[2]};
+    params[0].data() = 0.0;
+    EXPECT_THROW(snapshot.restore(last_not_leaf), std::runtime_error);
+    EXPECT_DOUBLE_EQ(0.0, params[0].data());
+    EXPECT_THROW(Snapshot<float> wrong_type(path), std::runtime_error);
+    EXPECT_THROW(
+        Snapshot<double>::save(path, params, false, short_state), std::runtime_error
+    );
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/functions.h"
+#include "autograd/real/softmax.h"
+
+using namespace autograd;
+
+class SoftmaxTest : public testing::Test {
+   protected:
+    std::vector<AutoGrad<double>> xs = {
+        AutoGrad(1.0, true), AutoGrad(-2.0, true), AutoGrad(0.5, true)
+    };
+    std::vector<AutoGrad<double>> ys = {
+        AutoGrad(1.0, true), AutoGrad(-2.0, true), AutoGrad(0.5, true)
+    };
+
+    // log(sum(exp(x))) from separate nodes.
+    AutoGrad<double> naive_lse(std::span<const AutoGrad<double>> args) {
+        std::vector<AutoGrad<double>> exps;
+        for (const AutoGrad<double>& arg : args)
+            exps.push_back(Exp::call(arg));
+        return Ln::call(Sum<double>::call(exps));
+    }
+};
+
+TEST_F(SoftmaxTest, LogSumExpMatchesNaive) {
+    AutoGrad<double> fused = LogSumExp::call(xs);
+    AutoGrad<double> naive = naive_lse(ys);
+    fused.backward();
+    naive.backward();
+
+    EXPECT_DOUBLE_EQ(naive.data(), fused.data());
+    for (size_t i = 0; i < xs.size(); i++)
+        EXPECT_DOUBLE_EQ(ys[i].grad(), xs[i].grad());
+}
+
+TEST_F(SoftmaxTest, LargeInputsDoNotOverflow) {
+    std::vector<AutoGrad<double>> large = {AutoGrad(1000.0, true), AutoGrad(1000.0)};
+
+    AutoGrad<double> lse = LogSumExp::call(large);
+    std::vector<AutoGrad<double>> probs = Softmax::call(large);
+    AutoGrad<double> loss = CrossEntropy::call(large, 1);
+    loss.backward();
+
+    EXPECT_DOUBLE_EQ(1000.0 + std::log(2.0), lse.data());
+    EXPECT_NEAR(0.5, probs[0].data(), 1e-12);
+    EXPECT_DOUBLE_EQ(std::log(2.0), loss.data());
+    EXPECT_DOUBLE_EQ(0.5, large[0].grad());
+}
+
+TEST_F(SoftmaxTest, SoftmaxAndLogSoftmax) {
+    std::vector<AutoGrad<double>> probs = Softmax::call(xs);
+    std::vector<AutoGrad<double>> logs = LogSoftmax::call(ys);
+    probs[0].backward();
+    logs[2].backward();
+
+    const double p0 = probs[0].data();
+    double total = 0.0;
+    for (size_t i = 0; i < probs.size(); i++) {
+        total += probs[i].data();
+        EXPECT_DOUBLE_EQ(std::log(probs[i].data()), logs[i].data());
+    }
+    EXPECT_DOUBLE_EQ(1.0, total);
+    EXPECT_DOUBLE_EQ(p0 * (1.0 - p0), xs[0].grad());
+    EXPECT_DOUBLE_EQ(-p0 * probs[1].data(), xs[1].grad());
+    EXPECT_DOUBLE_EQ(1.0 - probs[2].data(), ys[2].grad());
+}
+
+TEST_F(SoftmaxTest, CrossEntropyIsOneNode) {
+    AutoGrad<double> loss = CrossEntropy::call(xs, 2);
+    AutoGrad<double> naive = naive_lse(ys) - ys[2];
+    EXPECT_EQ(3u, loss.get_node()->edges().size());
+    for (const auto& edge : loss.get_node()->edges())
+        EXPECT_TRUE(edge->is_leaf());
+    loss.backward();
+    naive.backward();
+
+    EXPECT_DOUBLE_EQ(naive.data(), loss.data());
+    for (size_t i = 0; i < xs.size(); i++)
+        EXPECT_NEAR(ys[i].grad(), xs[i].grad(), 1e-15);
+    EXPECT_THROW(CrossEntropy::call(xs, 3), std::runtime_error);
+}
+
+TEST_F(SoftmaxTest, Values) {
+    std::vector<Value<double>> values = {Value(1.0), Value(-2.0), Value(0.5)};
+
+    EXPECT_DOUBLE_EQ(LogSumExp::call(xs).data(), LogSumExp::call(values).data());
+    EXPECT_DOUBLE_EQ(Softmax::call(xs)[1].data(), Softmax::call(values)[1].data());
+    EXPECT_DOUBLE_EQ(
+        CrossEntropy::call(xs, 0).data(), CrossEntropy::call(values, 0).data()
+    );
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/core/sparse_table.h"
+
+using namespace autograd;
+
+TEST(SparseTableTest, OnlyTouchedRowsHaveGradients) {
+    SparseTable<double> table(1000000, 0.5);
+    std::vector<size_t> batch = {42, 7, 42};
+
+    std::vector<AutoGrad<double>> rows = table.lookup(batch);
+    AutoGrad<double> loss = rows[0] * rows[1] + rows[2];
+    loss.backward();
+    SparseGrad<double> grad = table.sparse_grad();
+
+    EXPECT_EQ(2u, table.touched());
+    EXPECT_EQ(rows[0].get_node(), rows[2].get_node());
+    ASSERT_EQ(2u, grad.size());
+    EXPECT_EQ(std::vector<size_t>({42, 7}), grad.indices);
+    EXPECT_DOUBLE_EQ(1.5, grad.values[0]);
+    EXPECT_DOUBLE_EQ(0.5, grad.values[1]);
+}
+
+TEST(SparseTableTest, SgdUpdatesTouchedRows) {
+    SparseTable<double> table({1.0, 2.0, 3.0, 4.0});
+    SparseSGD<double> sgd(0.1);
+
+    AutoGrad<double> loss = table.lookup(1) * table.lookup(3);
+    table.lookup(0);
+    loss.backward();
+    sgd.step(table);
+
+    EXPECT_EQ(0u, table.touched());
+    EXPECT_DOUBLE_EQ(1.0, table.value(0));
+    EXPECT_DOUBLE_EQ(2.0 - 0.1 * 4.0, table.value(1));
+    EXPECT_DOUBLE_EQ(3.0, table.value(2));
+    EXPECT_DOUBLE_EQ(4.0 - 0.1 * 2.0, table.value(3));
+    EXPECT_DOUBLE_EQ(1.6, table.lookup(1).data());
+}
+
+TEST(SparseTableTest, ZeroGradStartsNewStep) {
+    SparseTable<double> table(10, 1.0);
+
+    AutoGrad<double> loss = table.lookup(3) * table.lookup(4);
+    loss.backward();
+    table.zero_grad();
+
+    EXPECT_EQ(0u, table.sparse_grad().size());
+    EXPECT_FALSE(table.lookup(3).has_grad());
+    EXPECT_THROW(table.lookup(10), std::runtime_error);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+#include "autograd/real/activations.h"
+#include "autograd/real/functions.h"
+
+using namespace autograd;
+
+TEST(ValueTest, MatchesGraphResults) {
+    Value<double> x(0.5);
+    Value<double> y(-1.5);
+    AutoGrad<double> gx(0.5, true);
+    AutoGrad<double> gy(-1.5, true);
+
+    Value<double> r = Exp::call(x * y) + Pow<double>::call(x - y, 3) / -y;
+    AutoGrad<double> g = Exp::call(gx * gy) + Pow<double>::call(gx - gy, 3) / -gy;
+
+    EXPECT_DOUBLE_EQ(g.data(), r.data());
+    EXPECT_DOUBLE_EQ(0.5, LeakyReLU::call(Value(0.5), 0.1).data());
+    EXPECT_DOUBLE_EQ(-0.1, LeakyReLU::call(Value(-1.0), 0.1).data());
+}
+
+TEST(ValueTest, MultiAndVariadic) {
+    std::array<Value<double>, 4> points = {
+        Value(0.0), Value(0.0), Value(3.0), Value(4.0)
+    };
+    std::vector<Value<double>> xs = {Value(1.0), Value(2.0), Value(3.0)};
+    std::vector<Value<double>> ys = {Value(4.0), Value(5.0), Value(6.0)};
+
+    EXPECT_DOUBLE_EQ(5.0, Distance::call(points).data());
+    EXPECT_DOUBLE_EQ(6.0, Sum<double>::call(xs).data());
+    EXPECT_DOUBLE_EQ(2.0, Mean<double>::call(xs).data());
+    EXPECT_DOUBLE_EQ(6.0, Prod<double>::call(xs).data());
+    EXPECT_DOUBLE_EQ(32.0, Dot<double>::call(xs, ys).data());
+    std::vector<Value<double>> empty;
+    EXPECT_THROW(Sum<double>::call(empty), std::runtime_error);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "autograd/core/autograd.h"
+
+using namespace autograd;
+
+TEST(VariadicTest, Sum) {
+    std::vector<AutoGrad<double>> xs;
+    for (int i = 0; i < 1000; i++)
+        xs.emplace_back(static_cast<double>(i), true);
+
+    AutoGrad y = Sum<double>::call(xs);
+    y.backward();
+
+    EXPECT_DOUBLE_EQ(499500.0, y.data());
+    for (const AutoGrad<double>& x : xs)
+        EXPECT_DOUBLE_EQ(1.0, x.grad());
+}
+
+TEST(VariadicTest, Mean) {
+    std::vector<AutoGrad<double>> xs = {
+        AutoGrad(1.0, true), AutoGrad(2.0, true), AutoGrad(6.0, true), AutoGrad(7.0)
+    };
+
+    AutoGrad y = Mean<double>::call(xs);
+    y.backward();
+
+    EXPECT_DOUBLE_EQ(4.0, y.data());
+    EXPECT_DOUBLE_EQ(0.25, xs[0].grad());
+    EXPECT_DOUBLE_EQ(0.25, xs[2].grad());
+    EXPECT_FALSE(xs[3].has_grad());
+}
+
+TEST(VariadicTest, ProdWithZero) {
+    std::vector<AutoGrad<double>> xs = {
+        AutoGrad(2.0, true), AutoGrad(0.0, true), AutoGrad(3.0, true)
+    };
+
+    AutoGrad y = Prod<double>::call(xs);
+    y.backward();
+
+    EXPECT_DOUBLE_EQ(0.0, y.data());
+    EXPECT_DOUBLE_EQ(0.0, xs[0].grad());
+    EXPECT_DOUBLE_EQ(6.0, xs[1].grad());
+    EXPECT_DOUBLE_EQ(0.0, xs[2].grad());
+}
+
+TEST(VariadicTest, Dot) {
+    std::vector<AutoGrad<double>> xs = {AutoGrad(1.0, true), AutoGrad(2.0, true)};
+    std::vector<AutoGrad<double>> ys = {AutoGrad(3.0, true), AutoGrad(4.0, true)};
+
+    AutoGrad d = Dot<double>::call(xs, ys);
+    d.backward();
+
+    EXPECT_DOUBLE_EQ(11.0, d.data());
+    EXPECT_DOUBLE_EQ(3.0, xs[0].grad());
+    EXPECT_DOUBLE_EQ(4.0, xs[1].grad());
+    EXPECT_DOUBLE_EQ(1.0, ys[0].grad());
+    EXPECT_DOUBLE_EQ(2.0, ys[1].grad());
+}
+
+TEST(VariadicTest, RepeatedArgumentAccumulates) {
+    AutoGrad x(3.0, true);
+    std::vector<AutoGrad<double>> xs = {x, x, x};
+
+    AutoGrad y = Prod<double>::call(xs);
+    y.backward();
+
+    EXPECT_DOUBLE_EQ(27.0, y.data());
+    EXPECT_DOUBLE_EQ(27.0, x.grad());
+}
+
+TEST(VariadicTest, InvalidArgumentsThrow) {
+    std::vector<AutoGrad<double>> empty;
+    std::vector<AutoGrad<double>> one = {AutoGrad(1.0, true)};
+
+    EXPECT_THROW(Sum<double>::call(empty), std::runtime_error);
+    EXPECT_THROW(Dot<double>::call(one, empty), std::runtime_error);
+}